@@ -0,0 +1,141 @@
+#include "atlas.h"
+#include <algorithm>
+#include <climits>
+#include <cstdint>
+
+void TextureAtlas::init(SDL_Renderer *r, int size)
+{
+    release();
+    renderer = r;
+    pageSize = size;
+
+    SDL_RendererInfo info;
+    if (renderer && SDL_GetRendererInfo(renderer, &info) == 0) {
+        if (info.max_texture_width  > 0) pageSize = min(pageSize, info.max_texture_width);
+        if (info.max_texture_height > 0) pageSize = min(pageSize, info.max_texture_height);
+    }
+}
+
+void TextureAtlas::release()
+{
+    for (auto &p : pages)
+        if (p.texture) SDL_DestroyTexture(p.texture);
+    pages.clear();
+}
+
+bool TextureAtlas::newPage()
+{
+    SDL_Texture *tex = SDL_CreateTexture(renderer, SDL_PIXELFORMAT_ARGB8888, SDL_TEXTUREACCESS_STATIC,
+                                         pageSize, pageSize);
+    if (!tex) return false;
+
+    // página começa transparente
+    vector<Uint32> zeros((size_t)pageSize * pageSize, 0);
+    SDL_UpdateTexture(tex, nullptr, zeros.data(), pageSize * 4);
+    SDL_SetTextureBlendMode(tex, SDL_BLENDMODE_BLEND);
+
+    Page p;
+    p.texture = tex;
+    p.skyline.push_back({ 0, 0, pageSize });
+    pages.push_back(move(p));
+    return true;
+}
+
+// y onde um retângulo w x h apoiaria começando no nó index (-1 se não cabe)
+int TextureAtlas::fit(const Page &p, size_t index, int w, int h) const
+{
+    const int x = p.skyline[index].x;
+    if (x + w > pageSize) return -1;
+
+    int y = p.skyline[index].y;
+    int widthLeft = w;
+    for (size_t i = index; widthLeft > 0; ++i) {
+        if (i >= p.skyline.size()) return -1;
+        y = max(y, p.skyline[i].y);
+        if (y + h > pageSize) return -1;
+        widthLeft -= p.skyline[i].w;
+    }
+    return y;
+}
+
+bool TextureAtlas::place(Page &p, int w, int h, int &outX, int &outY)
+{
+    int bestY = INT_MAX, bestW = INT_MAX;
+    size_t bestIndex = SIZE_MAX;
+
+    for (size_t i = 0; i < p.skyline.size(); ++i) {
+        int y = fit(p, i, w, h);
+        if (y < 0) continue;
+        if (y + h < bestY || (y + h == bestY && p.skyline[i].w < bestW)) {
+            bestY = y + h;
+            bestW = p.skyline[i].w;
+            bestIndex = i;
+            outX = p.skyline[i].x;
+            outY = y;
+        }
+    }
+    if (bestIndex == SIZE_MAX) return false;
+
+    // novo nó no topo do retângulo e encolhe os que ficaram por baixo
+    p.skyline.insert(p.skyline.begin() + bestIndex, SkyNode{ outX, outY + h, w });
+    for (size_t i = bestIndex + 1; i < p.skyline.size(); ++i) {
+        SkyNode &prev = p.skyline[i - 1];
+        SkyNode &cur  = p.skyline[i];
+        if (cur.x >= prev.x + prev.w) break;
+        const int shrink = prev.x + prev.w - cur.x;
+        cur.x += shrink;
+        cur.w -= shrink;
+        if (cur.w > 0) break;
+        p.skyline.erase(p.skyline.begin() + i);
+        --i;
+    }
+    // junta vizinhos na mesma altura
+    for (size_t i = 0; i + 1 < p.skyline.size();) {
+        if (p.skyline[i].y == p.skyline[i + 1].y) {
+            p.skyline[i].w += p.skyline[i + 1].w;
+            p.skyline.erase(p.skyline.begin() + i + 1);
+        } else {
+            ++i;
+        }
+    }
+    return true;
+}
+
+bool TextureAtlas::add(SDL_Surface *surface, AtlasRegion &out)
+{
+    if (!renderer || !surface) return false;
+
+    const int w = surface->w + PADDING;
+    const int h = surface->h + PADDING;
+    if (w > pageSize || h > pageSize) return false;
+
+    SDL_Surface *conv = surface;
+    if (surface->format->format != SDL_PIXELFORMAT_ARGB8888) {
+        conv = SDL_ConvertSurfaceFormat(surface, SDL_PIXELFORMAT_ARGB8888, 0);
+        if (!conv) return false;
+    }
+
+    int x = 0, y = 0, page = -1;
+    for (size_t i = 0; i < pages.size(); ++i) {
+        if (place(pages[i], w, h, x, y)) { page = (int)i; break; }
+    }
+    if (page < 0) {
+        if (newPage() && place(pages.back(), w, h, x, y)) page = (int)pages.size() - 1;
+    }
+
+    bool ok = false;
+    if (page >= 0) {
+        SDL_Rect dst{ x, y, surface->w, surface->h };
+        if (SDL_MUSTLOCK(conv)) SDL_LockSurface(conv);
+        ok = SDL_UpdateTexture(pages[page].texture, &dst, conv->pixels, conv->pitch) == 0;
+        if (SDL_MUSTLOCK(conv)) SDL_UnlockSurface(conv);
+        if (ok) {
+            out.texture = pages[page].texture;
+            out.src     = dst;
+            out.page    = page;
+        }
+    }
+
+    if (conv != surface) SDL_FreeSurface(conv);
+    return ok;
+}
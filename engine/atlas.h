@@ -0,0 +1,53 @@
+#pragma once
+#include <SDL2/SDL.h>
+#include <vector>
+
+using namespace std;
+
+// Região de uma imagem dentro de uma página do atlas
+struct AtlasRegion {
+    SDL_Texture *texture = nullptr;  // página (pertence ao atlas)
+    SDL_Rect     src{0, 0, 0, 0};
+    int          page = -1;
+};
+
+// Atlas de texturas montado na carga: cada imagem é empacotada (skyline
+// bottom-left) numa página grande, e os desenhos usam retângulos de origem.
+// Menos trocas de textura por frame e menos fragmentação de VRAM.
+class TextureAtlas {
+public:
+    static constexpr int DEFAULT_PAGE_SIZE = 2048;
+    static constexpr int PADDING = 2;  // borda transparente entre imagens
+
+    TextureAtlas() = default;
+    ~TextureAtlas() { release(); }
+
+    TextureAtlas(const TextureAtlas&) = delete;
+    TextureAtlas& operator=(const TextureAtlas&) = delete;
+
+    // pageSize é limitado ao máximo que o renderer aceita
+    void init(SDL_Renderer *renderer, int pageSize = DEFAULT_PAGE_SIZE);
+    void release();
+
+    // Copia a superfície pra uma página. false se não couber (imagem maior que a página).
+    bool add(SDL_Surface *surface, AtlasRegion &out);
+
+    int pageCount() const { return (int)pages.size(); }
+    int getPageSize() const { return pageSize; }
+    SDL_Texture *getPage(int i) const { return pages[i].texture; }
+
+private:
+    struct SkyNode { int x, y, w; };
+    struct Page {
+        SDL_Texture    *texture = nullptr;
+        vector<SkyNode> skyline;
+    };
+
+    SDL_Renderer *renderer = nullptr;
+    int pageSize = DEFAULT_PAGE_SIZE;
+    vector<Page> pages;
+
+    bool newPage();
+    int  fit(const Page &p, size_t index, int w, int h) const;
+    bool place(Page &p, int w, int h, int &outX, int &outY);
+};
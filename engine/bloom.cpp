@@ -0,0 +1,115 @@
+#include "bloom.h"
+
+// binomial 1 4 6 4 1 (/16), em 0..255 pro color mod
+static const int   BLOOM_TAPS = 5;
+static const Uint8 BLOOM_WEIGHTS[BLOOM_TAPS] = { 16, 64, 96, 64, 16 };
+
+SDL_Texture* Bloom::target(int w, int h)
+{
+    SDL_Texture *t = SDL_CreateTexture(renderer, SDL_PIXELFORMAT_ARGB8888, SDL_TEXTUREACCESS_TARGET, w, h);
+    if (!t) return nullptr;
+    SDL_SetTextureScaleMode(t, SDL_ScaleModeLinear);
+    return t;
+}
+
+bool Bloom::create()
+{
+    if (!renderer || !state) return false;
+
+    emissive = target(width / 2, height / 2);
+    bool ok = emissive && state->textureBlend(emissive, SDL_BLENDMODE_NONE);
+    for (int i = 0; ok && i < LEVELS; ++i) {
+        levelW[i] = max(1, width  >> (i + 2));
+        levelH[i] = max(1, height >> (i + 2));
+        levels[i] = target(levelW[i], levelH[i]);
+        temps[i]  = target(levelW[i], levelH[i]);
+        ok = levels[i] && temps[i] && state->textureBlend(temps[i], sum) && state->textureBlend(levels[i], sum);
+    }
+    if (!ok) {
+        release();
+        supported = false;
+    }
+    return ok;
+}
+
+void Bloom::release()
+{
+    auto destroy = [this](SDL_Texture *&t) {
+        if (!t) return;
+        if (state) state->forget(t);
+        SDL_DestroyTexture(t);
+        t = nullptr;
+    };
+    destroy(emissive);
+    for (int i = 0; i < LEVELS; ++i) {
+        destroy(levels[i]);
+        destroy(temps[i]);
+    }
+}
+
+bool Bloom::begin()
+{
+    if (!supported) return false;
+    if (!emissive && !create()) return false;
+
+    prevTarget = SDL_GetRenderTarget(renderer);
+    if (SDL_SetRenderTarget(renderer, emissive) != 0) {
+        release();
+        supported = false;
+        return false;
+    }
+    state->drawColor(0, 0, 0, 0);
+    SDL_RenderClear(renderer);
+    return true;
+}
+
+// 5 cópias deslocadas de 1 texel, cada uma com o peso no color mod, somadas com `sum`
+int Bloom::blurPass(SDL_Texture *src, SDL_Texture *dst, int w, int h, bool horizontal)
+{
+    SDL_SetRenderTarget(renderer, dst);
+    state->drawColor(0, 0, 0, 0);
+    SDL_RenderClear(renderer);
+    state->textureBlend(src, sum);
+    for (int k = 0; k < BLOOM_TAPS; ++k) {
+        const int off = k - BLOOM_TAPS / 2;
+        const Uint8 wgt = BLOOM_WEIGHTS[k];
+        state->textureColor(src, wgt, wgt, wgt);
+        const SDL_Rect d{ horizontal ? off : 0, horizontal ? 0 : off, w, h };
+        SDL_RenderCopy(renderer, src, nullptr, &d);
+    }
+    return BLOOM_TAPS;
+}
+
+int Bloom::composite()
+{
+    int calls = 0;
+
+    // redução: meia -> 1/4 -> 1/8 (filtro linear faz a média)
+    SDL_Texture *src = emissive;
+    for (int i = 0; i < LEVELS; ++i) {
+        SDL_SetRenderTarget(renderer, levels[i]);
+        state->textureBlend(src, SDL_BLENDMODE_NONE);
+        state->textureColor(src, 255, 255, 255);
+        SDL_RenderCopy(renderer, src, nullptr, nullptr);
+        ++calls;
+        src = levels[i];
+    }
+
+    // blur separável em cada nível: nível -> temp (horizontal) -> nível (vertical)
+    for (int i = 0; i < LEVELS; ++i) {
+        calls += blurPass(levels[i], temps[i], levelW[i], levelH[i], true);
+        calls += blurPass(temps[i], levels[i], levelW[i], levelH[i], false);
+    }
+
+    // soma na tela (ou no alvo de antes): os níveis esticados, com intensidade
+    SDL_SetRenderTarget(renderer, prevTarget);
+    prevTarget = nullptr;
+    const Uint8 mod = (Uint8)min(255.0f, 255.0f * intensity);
+    for (int i = 0; i < LEVELS; ++i) {
+        state->textureBlend(levels[i], sum);
+        state->textureColor(levels[i], mod, mod, mod);
+        SDL_RenderCopy(renderer, levels[i], nullptr, nullptr);
+        ++calls;
+    }
+    return calls;
+}
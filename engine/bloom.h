@@ -0,0 +1,62 @@
+#pragma once
+#include <SDL2/SDL.h>
+#include <cstdint>
+#include <algorithm>
+#include "renderstate.h"
+
+using namespace std;
+
+// Bloom de tela cheia: os objetos emissivos são desenhados num alvo de meia
+// resolução, que é reduzido (1/4, 1/8), borrado em dois passes separáveis em
+// cada nível e somado na tela. O custo é o mesmo com 1 ou 500 emissivos.
+//
+// Os alvos guardam só cor (alpha 0, emissivo = ADD num fundo preto), então a
+// soma entre eles e na tela usa um blend "ONE, ONE" próprio; renderers que não
+// aceitam blend composto ficam sem bloom (isSupported() == false).
+class Bloom {
+public:
+    static const int LEVELS = 2;     // 1/4 e 1/8 da tela
+
+    Bloom() = default;
+    ~Bloom() { release(); }
+
+    Bloom(const Bloom&) = delete;
+    Bloom& operator=(const Bloom&) = delete;
+
+    void setRenderer(SDL_Renderer *r, RenderState *s, int w, int h) { renderer = r; state = s; width = w; height = h; }
+
+    void setIntensity(float v) { intensity = v < 0.0f ? 0.0f : v; }
+    float getIntensity() const { return intensity; }
+
+    // escala das coordenadas de tela dentro do alvo emissivo
+    float getScale() const { return 0.5f; }
+
+    // passa a desenhar no alvo emissivo (limpo). false se não há suporte.
+    bool begin();
+    // borra e soma no alvo que estava ativo antes do begin(). Retorna as chamadas de desenho.
+    int  composite();
+
+    bool isSupported() const { return supported; }
+    void release();
+
+private:
+    SDL_Renderer *renderer = nullptr;
+    RenderState  *state    = nullptr;
+    int width = 0, height = 0;
+
+    SDL_Texture *emissive = nullptr;
+    SDL_Texture *levels[LEVELS] = {};
+    SDL_Texture *temps[LEVELS]  = {};
+    int levelW[LEVELS] = {}, levelH[LEVELS] = {};
+    SDL_Texture *prevTarget = nullptr;
+    float intensity = 1.0f;
+    bool  supported = true;
+
+    SDL_BlendMode sum = SDL_ComposeCustomBlendMode(
+        SDL_BLENDFACTOR_ONE, SDL_BLENDFACTOR_ONE, SDL_BLENDOPERATION_ADD,
+        SDL_BLENDFACTOR_ZERO, SDL_BLENDFACTOR_ONE, SDL_BLENDOPERATION_ADD);
+
+    bool create();
+    SDL_Texture* target(int w, int h);
+    int blurPass(SDL_Texture *src, SDL_Texture *dst, int w, int h, bool horizontal);
+};
@@ -0,0 +1,90 @@
+#pragma once
+#include <SDL2/SDL.h>
+#include <vector>
+#include <string>
+#include <utility>
+#include <cstdint>
+#include "handles.h"
+#include "gameobject.h"
+
+using namespace std;
+
+// Um pedido de desenho gravado durante o frame. Só valores (nada de Object*),
+// então a lista continua válida mesmo que a simulação destrua objetos depois.
+struct DrawCmd {
+    enum Type : uint8_t {
+        IMAGE,        // image, x/y/w/h, angle, fx
+        TEXT,         // str (texto), font (nome), size, x/y, color, centered, dynamic
+        RECT,         // x/y/w/h, color, filled
+        LINE,         // x/y -> x2/y2, color
+        CIRCLE,       // x/y, size = raio, color, filled
+        POINT,        // x/y, color
+        POLYGON,      // first/count em points, color, closed
+        LAYER_BEGIN,  // camada estática do depth; rebuild = membros gravados até LAYER_END
+        LAYER_END,
+        SPRITES       // first/count em sprites, fx (blend/glow) comum a todos
+    };
+
+    Type      type   = IMAGE;
+    int       depth  = 0;
+    int       x = 0, y = 0, w = 0, h = 0;
+    int       x2 = 0, y2 = 0;
+    int       size   = 0;
+    float     angle  = 0.0f;
+    TextureId image;
+    FxParams  fx;
+    Color     color{255, 255, 255, 255};
+    bool      flag   = false;    // filled / centered / closed / rebuild
+    bool      dynamic = false;
+    uint32_t  str = 0, font = 0; // índices em strings
+    uint32_t  first = 0, count = 0;
+    uint64_t  signature = 0;
+};
+
+// Um sprite de uma sequência SPRITES (partículas): só o que muda por sprite
+struct DrawSprite {
+    TextureId image;
+    int       x, y, w, h;
+    float     angle;
+    Color     tint;        // substitui tint/alpha do fx do comando
+};
+
+// Lista de comandos de um frame. clear() mantém a capacidade dos vetores e das
+// strings, então depois de alguns frames gravar não aloca mais nada.
+class DrawList {
+public:
+    vector<DrawCmd>         cmds;
+    vector<pair<int,int>>   points;    // vértices dos POLYGON
+    vector<DrawSprite>      sprites;   // sprites dos SPRITES
+
+    int objectsDrawn  = 0;
+    int objectsCulled = 0;
+    int particles     = 0;
+
+    void clear() {
+        cmds.clear();
+        points.clear();
+        sprites.clear();
+        stringCount = 0;
+        objectsDrawn = objectsCulled = particles = 0;
+    }
+
+    DrawCmd& add(DrawCmd::Type type, int depth) {
+        cmds.emplace_back();
+        DrawCmd &c = cmds.back();
+        c.type  = type;
+        c.depth = depth;
+        return c;
+    }
+
+    uint32_t addString(const string &s) {
+        if (stringCount == strings.size()) strings.emplace_back();
+        strings[stringCount] = s;   // reaproveita o buffer da string antiga
+        return uint32_t(stringCount++);
+    }
+    const string& getString(uint32_t i) const { return strings[i]; }
+
+private:
+    vector<string> strings;
+    size_t stringCount = 0;
+};
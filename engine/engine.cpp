@@ -1,5 +1,7 @@
 #include "engine.h"
 #include <cmath>
+#include <cstring>
+#include <climits>
 
 // grade do broad-phase
 static constexpr int ENGINE_COLL_CELL = 64;
@@ -10,25 +12,6 @@ static inline SDL_Color toSDL(const Color &c) {
 }
 
 // =============== FX helpers ===============
-struct TextureStateGuard {
-    SDL_Texture* t;
-    SDL_BlendMode bm;
-    Uint8 r,g,b,a;
-    explicit TextureStateGuard(SDL_Texture* tex) : t(tex) {
-        SDL_GetTextureBlendMode(t, &bm);
-        SDL_GetTextureColorMod(t, &r, &g, &b);
-        SDL_GetTextureAlphaMod(t, &a);
-    }
-    ~TextureStateGuard() {
-        if (!t) return;
-        SDL_SetTextureBlendMode(t, bm);
-        SDL_SetTextureColorMod(t, r, g, b);
-        SDL_SetTextureAlphaMod(t, a);
-    }
-    TextureStateGuard(const TextureStateGuard&) = delete;
-    TextureStateGuard& operator=(const TextureStateGuard&) = delete;
-};
-
 static inline SDL_BlendMode blendModeFromFx(FxBlend fx) {
     switch (fx) {
         case FxBlend::Normal: return SDL_BLENDMODE_BLEND;
@@ -49,23 +32,65 @@ static inline SDL_BlendMode blendModeFromFx(FxBlend fx) {
 }
 // ==========================================
 
+// =============== camadas estáticas ===============
+static inline void Engine_mix(uint64_t &h, uint64_t v) {
+    h ^= v + 0x9e3779b97f4a7c15ULL + (h << 6) + (h >> 2);
+}
+
+// Só BLEND/ADD dão o mesmo resultado compostos de uma camada transparente.
+// Com bloom, emissivos ficam fora: eles precisam ir pro alvo do bloom todo frame.
+static inline bool Engine_layerMember(const Object *o, bool bloom) {
+    return o->isStatic() && (o->fx.blend == FxBlend::Normal || o->fx.blend == FxBlend::Add) &&
+           !(bloom && o->fx.glowRadius > 0);
+}
+
+// Tudo que muda o que o objeto desenha: se a soma mudar, a camada é remontada
+static uint64_t Engine_layerSignature(const Object *o) {
+    uint64_t h = uint64_t(uintptr_t(o));
+    uint32_t angle;
+    const float a = o->getAngle();
+    memcpy(&angle, &a, sizeof angle);
+    Engine_mix(h, (uint64_t(uint32_t(Engine::objLeft(o))) << 32) | uint32_t(Engine::objTop(o)));
+    Engine_mix(h, (uint64_t(uint32_t(o->getW())) << 32) | uint32_t(o->getH()));
+    Engine_mix(h, (uint64_t(angle) << 32) | uint32_t(o->getCurrentImage().index));
+
+    const FxParams &fx = o->fx;
+    Engine_mix(h, (uint64_t(fx.blend) << 32) | (uint64_t(fx.tint_r) << 24) | (uint64_t(fx.tint_g) << 16) |
+                  (uint64_t(fx.tint_b) << 8) | fx.alpha);
+    Engine_mix(h, (uint64_t(uint32_t(fx.glowRadius)) << 32) | (uint64_t(fx.glow_r) << 24) |
+                  (uint64_t(fx.glow_g) << 16) | (uint64_t(fx.glow_b) << 8) | fx.glow_a);
+
+    const string text = o->getText();
+    if (!text.empty()) {
+        const Color c = o->getFontColor();
+        Engine_mix(h, hash<string>()(text));
+        Engine_mix(h, hash<string>()(o->getFontName()));
+        Engine_mix(h, (uint64_t(uint32_t(o->getFontSize())) << 32) | (uint64_t(c.r) << 24) |
+                      (uint64_t(c.g) << 16) | (uint64_t(c.b) << 8) | c.a);
+    }
+    return h;
+}
+// ==========================================
+
 Engine::~Engine()
 {
-    for (auto &[key, res] : resources) {
-        if (res.type == GameResource::TEXTURE) {
-            SDL_DestroyTexture(res.texture);
-            res.texture = nullptr;
-        }
-        if (res.type == GameResource::SOUND) {
-            Mix_FreeChunk(res.sound);
-            res.sound = nullptr;
-        }
-        if (res.type == GameResource::MUSIC) {
-            Mix_FreeMusic(res.music);
-            res.music = nullptr;
-        }        
-    }
-    resources.clear();
+    setThreaded(false);
+    loader.stop();
+    for (auto *store : { &textures, &sounds, &musics })
+        for (GameResource &res : *store) freeResource(res);
+    textures.clear();
+    sounds.clear();
+    musics.clear();
+    textureIds.clear();
+    soundIds.clear();
+    musicIds.clear();
+    atlas.release();
+    textCache.clear();
+    glyphAtlases.clear();
+    glowCache.clear();
+    layerCache.clear();
+    bloom.release();
+    softRenderer.release();
 
     if (renderer) SDL_DestroyRenderer(renderer);
     if (window)   SDL_DestroyWindow(window);
@@ -84,6 +109,7 @@ bool Engine::init(const char *title, int w, int h)
 {  
     this->w = w;
     this->h = h;
+    starfield.setBounds(w, h);
 
     if (SDL_Init(SDL_INIT_EVERYTHING) < 0) {
         log("Erro SDL_Init: ", SDL_GetError());
@@ -97,10 +123,30 @@ bool Engine::init(const char *title, int w, int h)
         return false;
     }
 
-    renderer = SDL_CreateRenderer(window, -1, SDL_RENDERER_ACCELERATED /*| SDL_RENDERER_PRESENTVSYNC*/);
-    if (!renderer) {
-        log("Erro CreateRenderer: ", SDL_GetError());
-        return false;
+    const char *envBackend = SDL_getenv("ENGINE_RENDERER");
+    if (envBackend && string(envBackend) == "software") backend = RenderBackend::Software;
+
+    if (backend == RenderBackend::Software) {
+        if (!softRenderer.init(window, w, h)) {
+            log("Erro SoftRenderer: ", SDL_GetError());
+            return false;
+        }
+        layerCache.disable();
+        log("Renderer de software, kernels: ", softRenderer.getKernelName());
+    } else {
+        renderer = SDL_CreateRenderer(window, -1, SDL_RENDERER_ACCELERATED /*| SDL_RENDERER_PRESENTVSYNC*/);
+        if (!renderer) {
+            log("Erro CreateRenderer: ", SDL_GetError());
+            return false;
+        }
+
+        atlas.init(renderer);
+        renderState.setRenderer(renderer);
+        spriteBatch.setRenderer(renderer, &renderState);
+        primBatch.setRenderer(renderer, &renderState);
+        glowCache.setRenderer(renderer, &renderState);
+        layerCache.setRenderer(renderer, &renderState, w, h);
+        bloom.setRenderer(renderer, &renderState, w, h);
     }
 
     int initialized_flags = IMG_Init(IMG_INIT_PNG);
@@ -118,133 +164,641 @@ bool Engine::init(const char *title, int w, int h)
         log("TTF_Init failed: ", TTF_GetError());
     }
 
+    applyPacing();
     running = true;
 
     return true;
 }
 
-void Engine::drawImage(string imageRef, int x, int y, int w, int h, float angle,
-                       const FxParams* fx)
+void Engine::setBloom(bool on)
 {
-    SDL_Rect dst{ x, y, w, h };
+    if (on && backend == RenderBackend::Software) {
+        log("Bloom não disponível no renderer de software", "");
+        return;
+    }
+    bloomOn = on;
+    layerResync = true;   // emissivos entram/saem das camadas estáticas
+}
 
-    auto it = resources.find(string(TEXTURE_PREFIX) + imageRef);
-    if (it == resources.end() || !it->second.texture) return;
+void Engine::setFramePacing(PaceMode mode)
+{
+    paceRequest = mode;
+    if (window) applyPacing();
+}
 
-    SDL_Texture* tex = it->second.texture;
+void Engine::applyPacing()
+{
+    PaceMode mode = paceRequest;
+    if (mode == PaceMode::VSync) {
+        if (!renderer || SDL_RenderSetVSync(renderer, 1) != 0) {
+            log("VSync indisponível, usando ritmo fixo ", pacer.getTargetFps());
+            mode = PaceMode::Fixed;
+        }
+    } else if (renderer) {
+        SDL_RenderSetVSync(renderer, 0);
+    }
+    pacer.setMode(mode);
+}
 
-    // salva/restaura estado automaticamente
-    TextureStateGuard guard(tex);
+void Engine::freeResource(GameResource &res)
+{
+    if (res.type == GameResource::TEXTURE) {
+        if (res.ownsTexture) {
+            if (res.texture) SDL_DestroyTexture(res.texture);
+            if (res.surface) SDL_FreeSurface(res.surface);
+        }
+        for (MipLevel &m : res.mips) {
+            if (!m.owns) continue;
+            if (m.texture) SDL_DestroyTexture(m.texture);
+            if (m.surface) SDL_FreeSurface(m.surface);
+        }
+        res.mips.clear();
+        res.texture = nullptr;
+        res.surface = nullptr;
+    }
+    if (res.type == GameResource::SOUND) {
+        Mix_FreeChunk(res.sound);
+        res.sound = nullptr;
+    }
+    if (res.type == GameResource::MUSIC) {
+        Mix_FreeMusic(res.music);
+        res.music = nullptr;
+    }
+}
 
-    // lê os efeitos (ou defaults neutros se fx == nullptr)
-    FxParams local;
-    if (fx) local = *fx;
+template <typename Id>
+Id Engine::storeResource(vector<GameResource> &store, unordered_map<string, Id> &ids,
+                         const string &tag, GameResource res)
+{
+    res.tag = tag;
+    auto it = ids.find(tag);
+    if (it != ids.end()) {
+        GameResource &old = store[it->second.index];
+        if (old.isLazy()) --lazyImages;
+        freeResource(old);
+        old = move(res);
+        if (old.isLazy()) ++lazyImages;
+        return it->second;
+    }
+    Id id;
+    id.index = (int32_t)store.size();
+    if (res.isLazy()) ++lazyImages;
+    store.push_back(move(res));
+    ids.emplace(tag, id);
+    return id;
+}
 
-    SDL_SetTextureBlendMode(tex, blendModeFromFx(local.blend));
-    SDL_SetTextureColorMod(tex, local.tint_r, local.tint_g, local.tint_b);
-    SDL_SetTextureAlphaMod(tex, local.alpha);
+TextureId Engine::findImage(const string &tag) const
+{
+    auto it = textureIds.find(tag);
+    return it != textureIds.end() ? it->second : TextureId{};
+}
 
-    SDL_Point center{ dst.w / 2, dst.h / 2 };
-    const SDL_Point* pCenter = (angle != 0.0f && local.centerRotate) ? &center : nullptr;
+SoundId Engine::findSound(const string &tag) const
+{
+    auto it = soundIds.find(tag);
+    return it != soundIds.end() ? it->second : SoundId{};
+}
 
-    // PATCH 1: não fixar alpha do glow dentro do copy()
-    auto copy = [&](int dx, int dy, Uint8 aOverride, bool useAddBlend) {
-        if (useAddBlend) {
-            SDL_SetTextureBlendMode(tex, SDL_BLENDMODE_ADD);
-            SDL_SetTextureColorMod(tex, local.glow_r, local.glow_g, local.glow_b);
-            // (removido) SDL_SetTextureAlphaMod(tex, local.glow_a);
-        }
-        if (aOverride != 255) SDL_SetTextureAlphaMod(tex, aOverride);
-        SDL_Rect d = dst; d.x += dx; d.y += dy;
-        if (angle == 0.0f) SDL_RenderCopy(renderer, tex, nullptr, &d);
-        else SDL_RenderCopyEx(renderer, tex, nullptr, &d, angle, pCenter, SDL_FLIP_NONE);
-    };
+MusicId Engine::findMusic(const string &tag) const
+{
+    auto it = musicIds.find(tag);
+    return it != musicIds.end() ? it->second : MusicId{};
+}
 
-    // PATCH 2: usar fx.glow_a como intensidade-mestre + falloff por anel
-    if (local.glowRadius > 0) {
+const string& Engine::getImageTag(TextureId id) const
+{
+    static const string none;
+    if (!id.valid() || id.index >= (int32_t)textures.size()) return none;
+    return textures[id.index].tag;
+}
+
+void Engine::drawImage(const string &imageRef, int x, int y, int w, int h, float angle,
+                       const FxParams* fx)
+{
+    drawImage(findImage(imageRef), x, y, w, h, angle, fx);
+}
+
+// Desenho fora do recordFrame (onStep, código do jogo entre frames) não tem
+// lista pra gravar e é descartado; avisa uma vez pra não passar em silêncio
+bool Engine::canRecord(const char *call)
+{
+    if (recording) return true;
+    if (!warnedOffFrameDraw.exchange(true))
+        log("Desenho fora dos callbacks de desenho ignorado: ", call);
+    return false;
+}
+
+void Engine::drawImage(TextureId image, int x, int y, int w, int h, float angle,
+                       const FxParams* fx)
+{
+    if (!canRecord("drawImage") || !image.valid()) return;
+    DrawCmd &c = recording->add(DrawCmd::IMAGE, recordDepth);
+    c.image = image;
+    c.x = x; c.y = y; c.w = w; c.h = h;
+    c.angle = angle;
+    if (fx) c.fx = *fx;   // senão fica com os defaults neutros
+}
+
+void Engine::renderImage(const DrawCmd &c)
+{
+    submitSprite(c.image, c.x, c.y, c.w, c.h, c.angle, c.fx, c.depth);
+}
+
+// Cada partícula é um sprite comum com o fx do emissor e a cor dela
+void Engine::renderSprites(const DrawCmd &c, const DrawList &list)
+{
+    FxParams fx = c.fx;
+    const DrawSprite *s = list.sprites.data() + c.first;
+    for (uint32_t i = 0; i < c.count; ++i, ++s) {
+        fx.tint_r = s->tint.r;
+        fx.tint_g = s->tint.g;
+        fx.tint_b = s->tint.b;
+        fx.alpha  = s->tint.a;
+        submitSprite(s->image, s->x, s->y, s->w, s->h, s->angle, fx, c.depth);
+    }
+}
+
+void Engine::submitSprite(TextureId image, int x, int y, int w, int h, float angle, const FxParams &local, int depth)
+{
+    if (!image.valid() || image.index >= (int32_t)textures.size()) return;
+    if (!textures[image.index].texture) return;
+    // nível de mip mais perto do tamanho na tela (sprites bem reduzidos leem bem menos texels)
+    const MipLevel level = pickMipLevel(textures, image.index, abs(w), abs(h));
+    if (!level.texture) return;
+
+    flushPrimitives();  // primitivas pedidas antes ficam por baixo
+
+    currentDepth = depth;
+
+    // tint/alpha vão na cor do vértice; o estado da textura não é tocado
+    SpriteCmd cmd;
+    cmd.texture = level.texture;
+    cmd.src     = level.src;
+    cmd.angle   = angle;
+    cmd.depth   = currentDepth;
+
+    // com bloom o glow vira um desenho emissivo em meia resolução; o halo sai do blur
+    if (local.glowRadius > 0 && bloomOn && bloom.isSupported()) {
+        const float s = bloom.getScale();
+        const MipLevel half = pickMipLevel(textures, image.index, int(abs(w) * s), int(abs(h) * s));
+        SpriteCmd emit = cmd;
+        emit.texture = half.texture;
+        emit.src     = half.src;
+        emit.dst   = SDL_FRect{ x * s, y * s, w * s, h * s };
+        emit.color = SDL_Color{ local.glow_r, local.glow_g, local.glow_b, local.glow_a };
+        emit.blend = SDL_BLENDMODE_ADD;
+        emit.depth = 0;
+        emit.layer = 0;
+        bloomSprites.push_back(emit);
+    }
+    // glow por baixo do sprite: halo assado uma vez (cache) + alpha = fx.glow_a,
+    // que continua podendo pulsar por frame sem custo extra
+    else if (local.glowRadius > 0) {
         const int R = local.glowRadius;
-        for (int r = 1; r <= R; ++r) {
-            const int off = r;
-            const int offsets[8][2] = {
-                {-off,0},{off,0},{0,-off},{0,off},{-off,-off},{-off,off},{off,-off},{off,off}
-            };
-            // falloff linear 1..~0; alpha final = local.glow_a * falloff
-            float falloff = 1.0f - (float)r / (R + 1);
-            Uint8 a = (Uint8)std::round(local.glow_a * falloff);
-            for (auto& v : offsets) copy(v[0], v[1], a, /*useAddBlend*/true);
+        const Uint32 rgb = (Uint32(local.glow_r) << 16) | (Uint32(local.glow_g) << 8) | local.glow_b;
+        const GlowHalo *halo = glowCache.get(GlowKey{ cmd.texture, cmd.src, w, h, R, rgb });
+
+        cmd.layer = 0;
+        cmd.blend = SDL_BLENDMODE_ADD;
+        if (halo) {
+            SpriteCmd glow = cmd;
+            glow.texture = halo->texture;
+            glow.src     = SDL_Rect{ 0, 0, halo->w, halo->h };
+            glow.dst     = SDL_FRect{ float(x - R), float(y - R), float(halo->w), float(halo->h) };
+            glow.color   = SDL_Color{ 255, 255, 255, local.glow_a };
+            spriteBatch.add(glow);
+        } else {
+            // sem render target: anéis aditivos a cada frame, falloff linear por anel
+            for (int r = 1; r <= R; ++r) {
+                const int off = r;
+                const int offsets[8][2] = {
+                    {-off,0},{off,0},{0,-off},{0,off},{-off,-off},{-off,off},{off,-off},{off,off}
+                };
+                float falloff = 1.0f - (float)r / (R + 1);
+                Uint8 a = (Uint8)std::round(local.glow_a * falloff);
+                cmd.color = SDL_Color{ local.glow_r, local.glow_g, local.glow_b, a != 255 ? a : local.alpha };
+                for (auto& v : offsets) {
+                    cmd.dst = SDL_FRect{ float(x + v[0]), float(y + v[1]), float(w), float(h) };
+                    spriteBatch.add(cmd);
+                }
+            }
         }
-        // restaura estado do sprite principal
-        SDL_SetTextureBlendMode(tex, blendModeFromFx(local.blend));
-        SDL_SetTextureColorMod(tex, local.tint_r, local.tint_g, local.tint_b);
-        SDL_SetTextureAlphaMod(tex, local.alpha);
     }
 
     // sprite principal
-    if (angle == 0.0f) SDL_RenderCopy(renderer, tex, nullptr, &dst);
-    else SDL_RenderCopyEx(renderer, tex, nullptr, &dst, angle, pCenter, SDL_FLIP_NONE);
+    cmd.layer = 1;
+    cmd.blend = blendModeFromFx(local.blend);
+    cmd.color = SDL_Color{ local.tint_r, local.tint_g, local.tint_b, local.alpha };
+    cmd.dst   = SDL_FRect{ float(x), float(y), float(w), float(h) };
+    spriteBatch.add(cmd);
+}
+
+void Engine::flushSprites()
+{
+    frameStats.drawCalls += spriteBatch.flush();
+}
+
+void Engine::flushPrimitives()
+{
+    frameStats.drawCalls += primBatch.flush();
+}
+
+void Engine::flushBatches()
+{
+    // no máximo um dos dois tem algo: cada um esvazia o outro antes de receber
+    flushSprites();
+    flushPrimitives();
+}
+
+// Só objetos com imagem e sem texto são testados: texto e callbacks não têm
+// área conhecida, então esses objetos sempre desenham.
+bool Engine::isOffscreen(const Object *obj) const
+{
+    if (!obj->isCullable() || !obj->getCurrentImage().valid()) return false;
+
+    float hw = obj->getW() * 0.5f;
+    float hh = obj->getH() * 0.5f;
+    const float cx = drawLeft(obj) + hw;
+    const float cy = drawTop(obj)  + hh;
+
+    // caixa do quad girado em torno do centro
+    const float angle = std::fmod(obj->getAngle(), 180.0f);
+    if (angle != 0.0f) {
+        const float rad = angle * float(M_PI / 180.0);
+        const float cs = std::fabs(std::cos(rad)), sn = std::fabs(std::sin(rad));
+        const float rw = hw * cs + hh * sn;
+        const float rh = hw * sn + hh * cs;
+        hw = rw;
+        hh = rh;
+    }
+
+    // halo do glow se estende glowRadius pra cada lado
+    const float pad = obj->fx.glowRadius > 0 ? float(obj->fx.glowRadius) : 0.0f;
+    hw += pad;
+    hh += pad;
+
+    const bool outside = cx + hw <= 0.0f || cx - hw >= float(w) ||
+                         cy + hh <= 0.0f || cy - hh >= float(h);
+    return outside && obj->getText().empty();
 }
 
 void Engine::drawObject(Object *go)
 {
+    recordDepth = go->getDepth();
     if (go->onBeforeDraw) go->onBeforeDraw(go);
 
     // imagem (usa AABB consistente)
-    const string img = go->getCurrentImageRef();
-    if (!img.empty()) {
+    const TextureId img = go->getCurrentImage();
+    if (img.valid()) {
         // passa os FX do próprio objeto (retrocompat: se não mexer em go->fx, é neutro)
-        drawImage(img, objLeft(go), objTop(go), go->getW(), go->getH(), go->getAngle(), &go->fx);
+        drawImage(img, drawLeft(go), drawTop(go), go->getW(), go->getH(), go->getAngle(), &go->fx);
     }
 
-    // texto exatamente na posição do objeto
+    // texto exatamente na posição do objeto (a fonte é aberta no desenho, não aqui)
     if (!go->getText().empty() && !go->getFontName().empty()) {
         int fsize = go->getFontSize() > 0 ? go->getFontSize() : 16;
-        TTF_Font *font = getFont(go->getFontName(), fsize);
-        if (font) {
-            const bool centerText = go->isCentered();
-            const int tx = int(go->getX());
-            const int ty = int(go->getY());
-            drawText(go->getText(), tx, ty, go->getFontName(), fsize, toSDL(go->getFontColor()), centerText);
-        }
+        const bool centerText = go->isCentered();
+        const int tx = int(interpX(go));
+        const int ty = int(interpY(go));
+        drawText(go->getText(), tx, ty, go->getFontName(), fsize, toSDL(go->getFontColor()), centerText,
+                 go->isTextDynamic());
     }
 
     if (go->onAfterDraw) go->onAfterDraw(go);
 }
 
-void Engine::loadImage(string path, string tag)
+TextureId Engine::loadImage(const string &path, const string &tag, float maxScale)
 {
     SDL_Surface *surface = IMG_Load(path.c_str());
     if (!surface) {
         log("Erro IMG_Load: ", IMG_GetError());
-        return;
+        return TextureId{};
+    }
+    const SDL_Point size{ surface->w, surface->h };
+    GameResource res = makeImage(buildMipChain(surface, maxScale), size);
+    res.path     = path;   // se for avulsa e sair por orçamento, volta do arquivo
+    res.maxScale = maxScale;
+    return storeResource(textures, textureIds, tag, move(res));
+}
+
+// Sobe a cadeia de mips (libera as superfícies no GPU; no software elas viram
+// os próprios níveis). packed = false: texturas próprias, que podem ser
+// despejadas sozinhas
+GameResource Engine::makeImage(const vector<SDL_Surface*> &levels, SDL_Point size, bool packed)
+{
+    auto upload = [&](SDL_Surface *surface) {
+        MipLevel lv;
+        if (backend == RenderBackend::Software) {
+            lv.surface = surface;
+            lv.src     = SDL_Rect{ 0, 0, surface->w, surface->h };
+            lv.owns    = true;
+            return lv;
+        }
+        // tenta empacotar no atlas; imagens maiores que a página ficam sozinhas
+        AtlasRegion region;
+        if (packed && atlas.add(surface, region)) {
+            lv.texture = region.texture;
+            lv.src     = region.src;
+        } else {
+            lv.texture = SDL_CreateTextureFromSurface(renderer, surface);
+            lv.src     = SDL_Rect{ 0, 0, surface->w, surface->h };
+            lv.owns    = true;
+        }
+        SDL_FreeSurface(surface);
+        return lv;
+    };
+
+    GameResource res;
+    res.type = GameResource::TEXTURE;
+    res.size = size;
+    if (levels.empty()) return res;
+
+    const MipLevel top = upload(levels[0]);
+    res.texture     = top.texture;
+    res.surface     = top.surface;
+    res.src         = top.src;
+    res.ownsTexture = top.owns;
+    for (size_t i = 1; i < levels.size(); ++i) {
+        const MipLevel lv = upload(levels[i]);
+        if (lv.texture || lv.surface) res.mips.push_back(lv);
+    }
+    return res;
+}
+
+TextureId Engine::registerImage(const string &path, const string &tag, float maxScale)
+{
+    int iw = 0, ih = 0;
+    if (!ImageLoader::probeSize(path, iw, ih)) {
+        log("Erro ao ler tamanho da imagem: ", path);
+        return TextureId{};
+    }
+    GameResource res = GameResource::CreateLazy(path, iw, ih);
+    res.maxScale = maxScale;
+    return storeResource(textures, textureIds, tag, move(res));
+}
+
+void Engine::prefetchImage(TextureId image)
+{
+    if (!image.valid()) return;
+    lock_guard<mutex> lock(prefetchMutex);
+    prefetchQueue.push_back(image.index);
+}
+
+bool Engine::isImageResident(TextureId id) const
+{
+    if (!id.valid() || id.index >= (int32_t)textures.size()) return false;
+    const GameResource &res = textures[id.index];
+    return res.texture != nullptr || res.surface != nullptr;
+}
+
+// Troca a entrada preguiçosa pela imagem carregada. O tamanho nominal veio do
+// registro e é o único campo que a simulação lê; src e mips são da thread principal.
+// Fica fora do atlas pra poder sair sozinha quando o orçamento apertar
+void Engine::adoptImage(int32_t index, const vector<SDL_Surface*> &levels)
+{
+    GameResource img = makeImage(levels, textures[index].size, false);
+    GameResource &res = textures[index];
+    res.texture     = img.texture;
+    res.surface     = img.surface;
+    res.ownsTexture = img.ownsTexture;
+    res.src         = img.src;
+    res.mips        = move(img.mips);
+    // conta como uso: um prefetch não pode ser o primeiro da fila do despejo
+    // no mesmo frame em que subiu, antes de ser desenhado
+    res.lastUsed    = frameIndex;
+    if (!res.texture && !res.surface) {
+        log("Erro ao enviar imagem: ", res.path);
+        failImage(index);
     }
-    SDL_Texture *texture = SDL_CreateTextureFromSurface(renderer, surface);
-    SDL_FreeSurface(surface);
+    --lazyImages;
+}
 
-    resources[string(TEXTURE_PREFIX) + tag] = GameResource::CreateTexture(texture);
+// Sem path a entrada deixa de ser preguiçosa e não tenta de novo a cada frame.
+// As partes soltam a dona (e as referências que estavam nela): sem isso ficariam
+// preguiçosas pra sempre e o resolveImages varreria todo frame
+void Engine::failImage(int32_t index)
+{
+    GameResource &res = textures[index];
+    res.path.clear();
+    for (GameResource &part : textures) {
+        if (part.base != index) continue;
+        if (part.isLazy()) --lazyImages;
+        res.refs.n -= part.refs.n.load();
+        part.base = -1;
+    }
 }
 
-void Engine::splitImage(string baseImageRef, int numberOfParts, string baseTag)
+bool Engine::ensureResident(int32_t index)
 {
-    string fullRef = string(TEXTURE_PREFIX) + baseImageRef;
-    if (resources.find(fullRef) == resources.end()) {
+    if (index < 0 || index >= (int32_t)textures.size()) return false;
+    GameResource &res = textures[index];
+    if (!res.isLazy()) return res.texture != nullptr || res.surface != nullptr;
+
+    // parte: janela no nível 0 da imagem dona
+    if (res.base >= 0) {
+        if (!ensureResident(res.base)) return false;
+        const MipLevel top = pickMipLevel(textures, index, INT_MAX, INT_MAX);
+        res.texture = top.texture;
+        res.surface = top.surface;
+        res.src     = top.src;
+        --lazyImages;
+        return true;
+    }
+
+    // sem prefetch (ou ainda na fila): decodifica aqui mesmo
+    const vector<SDL_Surface*> levels = ImageLoader::decode(res.path, res.maxScale);
+    if (levels.empty()) {
+        failImage(index);
+        --lazyImages;
+        return false;
+    }
+    adoptImage(index, levels);
+    return res.texture != nullptr || res.surface != nullptr;
+}
+
+void Engine::uploadPrefetched()
+{
+    vector<int32_t> requests;
+    {
+        lock_guard<mutex> lock(prefetchMutex);
+        requests.swap(prefetchQueue);
+    }
+    for (int32_t index : requests) {
+        if (index < 0 || index >= (int32_t)textures.size()) continue;
+        // parte: o que carrega é a base
+        if (textures[index].base >= 0 && textures[index].isLazy()) index = textures[index].base;
+        const GameResource &res = textures[index];
+        if (res.isLazy() && res.base < 0)
+            loader.request(index, res.path, res.maxScale);
+    }
+
+    loadedImages.clear();
+    loader.collect(loadedImages);
+    for (LoadedImage &img : loadedImages) {
+        // falhou no fundo: o primeiro uso tenta de novo e loga
+        if (img.levels.empty()) continue;
+        if (img.index < (int32_t)textures.size() && textures[img.index].isLazy() && textures[img.index].base < 0)
+            adoptImage(img.index, img.levels);
+        else
+            for (SDL_Surface *level : img.levels) SDL_FreeSurface(level);   // já carregada no primeiro uso
+    }
+}
+
+// Garante pixels pra toda imagem que o frame desenha e carimba o uso (LRU)
+void Engine::resolveImages(const DrawList &list)
+{
+    if (lazyImages == 0 && imageBudget == 0) return;
+    auto use = [this](TextureId id) {
+        if (!id.valid() || id.index >= (int32_t)textures.size()) return;
+        GameResource &res = textures[id.index];
+        res.lastUsed = frameIndex;
+        if (res.base >= 0) textures[res.base].lastUsed = frameIndex;
+        if (lazyImages > 0) ensureResident(id.index);
+    };
+    for (const DrawCmd &c : list.cmds) {
+        if (c.type == DrawCmd::IMAGE) {
+            use(c.image);
+        } else if (c.type == DrawCmd::SPRITES) {
+            for (uint32_t i = c.first; i < c.first + c.count; ++i) use(list.sprites[i].image);
+        }
+    }
+}
+
+void Engine::retainImage(TextureId id)
+{
+    if (!id.valid() || id.index >= (int32_t)textures.size()) return;
+    GameResource &res = textures[id.index];
+    ++res.refs.n;
+    if (res.base >= 0) ++textures[res.base].refs.n;
+}
+
+void Engine::releaseImage(TextureId id)
+{
+    if (!id.valid() || id.index >= (int32_t)textures.size()) return;
+    GameResource &res = textures[id.index];
+    --res.refs.n;
+    if (res.base >= 0) --textures[res.base].refs.n;
+}
+
+bool Engine::isEvictable(const GameResource &res) const
+{
+    return res.type == GameResource::TEXTURE && res.ownsTexture && res.base < 0 &&
+           !res.path.empty() && (res.texture || res.surface) && res.refs.n.load() <= 0;
+}
+
+size_t Engine::residentImageBytes() const
+{
+    size_t total = size_t(atlas.pageCount()) * atlas.getPageSize() * atlas.getPageSize() * 4;
+    for (const GameResource &res : textures) total += res.bytes();
+    return total;
+}
+
+// Libera os pixels e volta a entrada pro estado registrado; as partes ligadas
+// a ela voltam a esperar a base
+void Engine::evictImage(int32_t index)
+{
+    GameResource &res = textures[index];
+    for (GameResource &part : textures) {
+        if (part.base != index || (!part.texture && !part.surface)) continue;
+        part.texture = nullptr;
+        part.surface = nullptr;
+        ++lazyImages;
+    }
+
+    auto drop = [this](SDL_Texture *texture, SDL_Surface *surface) {
+        if (texture) {
+            glowCache.forget(texture);
+            renderState.forget(texture);
+            SDL_DestroyTexture(texture);
+        }
+        if (surface) {
+            softRenderer.forget(surface);
+            SDL_FreeSurface(surface);
+        }
+    };
+    drop(res.texture, res.surface);
+    for (const MipLevel &m : res.mips)
+        if (m.owns) drop(m.texture, m.surface);
+    res.mips.clear();
+    res.texture     = nullptr;
+    res.surface     = nullptr;
+    res.ownsTexture = false;
+    ++lazyImages;
+    ++evictions;
+}
+
+// Acima do orçamento: despeja as avulsas sem objetos, menos usadas primeiro.
+// O que foi desenhado neste frame nunca sai
+void Engine::enforceBudget()
+{
+    if (imageBudget == 0) return;
+    size_t used = residentImageBytes();
+    if (used <= imageBudget) return;
+
+    vector<int32_t> candidates;
+    for (int32_t i = 0; i < (int32_t)textures.size(); ++i)
+        if (isEvictable(textures[i]) && textures[i].lastUsed < frameIndex) candidates.push_back(i);
+    sort(candidates.begin(), candidates.end(),
+         [this](int32_t a, int32_t b) { return textures[a].lastUsed < textures[b].lastUsed; });
+
+    for (int32_t index : candidates) {
+        if (used <= imageBudget) break;
+        used -= textures[index].bytes();
+        evictImage(index);
+    }
+}
+
+MemoryReport Engine::memoryReport() const
+{
+    MemoryReport report;
+    report.atlasBytes = size_t(atlas.pageCount()) * atlas.getPageSize() * atlas.getPageSize() * 4;
+    report.budget     = imageBudget;
+    report.evictions  = evictions;
+    for (auto *store : { &textures, &sounds, &musics }) {
+        for (const GameResource &res : *store) {
+            ResourceUsage u;
+            u.tag       = res.tag;
+            u.type      = res.type;
+            u.bytes     = res.bytes();
+            u.refs      = res.refs.n.load();
+            u.resident  = res.texture || res.surface || res.sound || res.music;
+            u.evictable = isEvictable(res);
+            u.lastUsed  = res.lastUsed;
+            if (res.type == GameResource::TEXTURE) report.imageBytes += u.bytes;
+            if (res.type == GameResource::SOUND)   report.soundBytes += u.bytes;
+            report.items.push_back(move(u));
+        }
+    }
+    return report;
+}
+
+void Engine::splitImage(const string &baseImageRef, int numberOfParts, const string &baseTag)
+{
+    TextureId base = findImage(baseImageRef);
+    if (!base.valid()) {
         cerr << "Erro: Textura base '" << baseImageRef << "' não encontrada!\n";
         return;
     }
 
-    SDL_Texture *originalTexture = resources[fullRef].texture;
-    if (!originalTexture) {
+    // copia: storeResource abaixo pode realocar o vetor. As partes ficam em
+    // coordenadas nominais da imagem dona e são ligadas aos pixels (e aos mips
+    // dela) no primeiro desenho
+    const GameResource &baseRes = textures[base.index];
+    if (!baseRes.texture && !baseRes.surface && !baseRes.isLazy()) {
         log("Erro: Textura base é nula! ", "");
         return;
     }
+    const int32_t rootIndex = baseRes.base >= 0 ? baseRes.base : base.index;
+    const SDL_Point origin  = baseRes.base >= 0 ? SDL_Point{ baseRes.part.x, baseRes.part.y } : SDL_Point{ 0, 0 };
 
     if (numberOfParts <= 1) {
         log("Erro: Número de partes deve ser pelo menos 2! ", "");
         return;
     }
 
-    Uint32 fmt; int access;
-    int originalWidth, originalHeight;
-    SDL_QueryTexture(originalTexture, &fmt, &access, &originalWidth, &originalHeight);
+    const int originalWidth  = baseRes.size.x;
+    const int originalHeight = baseRes.size.y;
 
     int partsTop, partsBottom;
     if (numberOfParts % 2 == 0) {
@@ -268,26 +822,11 @@ void Engine::splitImage(string baseImageRef, int numberOfParts, string baseTag)
             int srcW = (i == cols - 1) ? (originalWidth - i * colW) : colW;
             if (srcW <= 0) continue;
 
-            SDL_Texture *partTexture = SDL_CreateTexture(renderer, fmt, SDL_TEXTUREACCESS_TARGET, srcW, rowH);
-            if (!partTexture) {
-                log("Erro ao criar textura da parte ", to_string(partIndex) + " - " + SDL_GetError());
-                ++partIndex;
-                continue;
-            }
-            SDL_SetTextureBlendMode(partTexture, SDL_BLENDMODE_BLEND);
-
-            SDL_SetRenderTarget(renderer, partTexture);
-            SDL_SetRenderDrawColor(renderer, 0, 0, 0, 0);
-            SDL_RenderClear(renderer);
-
-            SDL_Rect srcRect{ i * colW, rowY, srcW, rowH };
-            SDL_Rect dstRect{ 0, 0, srcW, rowH };
-            SDL_RenderCopy(renderer, originalTexture, &srcRect, &dstRect);
-
-            SDL_SetRenderTarget(renderer, nullptr);
+            // a parte é só uma janela na textura da imagem base (sem VRAM nem render target)
+            SDL_Rect partRect{ origin.x + i * colW, origin.y + rowY, srcW, rowH };
 
             string partTag = baseTag + to_string(partIndex + 1);
-            resources[string(TEXTURE_PREFIX) + partTag] = GameResource::CreateTexture(partTexture);
+            storeResource(textures, textureIds, partTag, GameResource::CreatePart(rootIndex, partRect));
 
             ++partIndex;
         }
@@ -298,48 +837,63 @@ void Engine::splitImage(string baseImageRef, int numberOfParts, string baseTag)
     createSlice(topH,  bottomH, partsBottom, partIndex);
 }
 
-void Engine::playSound(string soundRef)
+void Engine::playSound(SoundId sound)
+{
+    if (!sound.valid() || sound.index >= (int32_t)sounds.size()) return;
+    Mix_Chunk *chunk = sounds[sound.index].sound;
+    if (chunk) Mix_PlayChannel(-1, chunk, 0);
+}
+
+void Engine::playSound(const string &soundRef)
 {
-    Mix_Chunk *sound = resources[string(SOUND_PREFIX) + soundRef].sound;
-    Mix_PlayChannel(-1, sound, 0);
+    playSound(findSound(soundRef));
 }
 
-void Engine::loadSound(string path, string soundRef)
+SoundId Engine::loadSound(const string &path, const string &soundRef)
 {
     Mix_Chunk *sound = Mix_LoadWAV(path.c_str());
     if (!sound) {
         log("Erro Mix_LoadWAV:  ", Mix_GetError());
-        return;
+        return SoundId{};
     }
-    resources[string(SOUND_PREFIX) + soundRef] = GameResource::CreateSound(sound);
+    return storeResource(sounds, soundIds, soundRef, GameResource::CreateSound(sound));
 }
 
-void Engine::loadMusic(const string& path, const string& tag)
+MusicId Engine::loadMusic(const string& path, const string& tag)
 {
     Mix_Music* mus = Mix_LoadMUS(path.c_str());
     if (!mus) {
         log("Erro Mix_LoadMUS: ", Mix_GetError());
-        return;
+        return MusicId{};
     }
-    resources[string(MUSIC_PREFIX) + tag] = GameResource::CreateMusic(mus);
+    return storeResource(musics, musicIds, tag, GameResource::CreateMusic(mus));
 }
 
 void Engine::playMusic(const string& tag, int loops)
 {
-    const string key = string(MUSIC_PREFIX) + tag;
-    auto it = resources.find(key);
-    if (it == resources.end() || it->second.type != GameResource::MUSIC || !it->second.music) {
+    MusicId id = findMusic(tag);
+    if (!id.valid()) {
         log("Música não encontrada: ", tag);
         return;
     }
+    playMusic(id, loops);
+}
+
+void Engine::playMusic(MusicId music, int loops)
+{
+    if (!music.valid() || music.index >= (int32_t)musics.size() || !musics[music.index].music) {
+        log("Música não encontrada: ", music.index);
+        return;
+    }
+    const GameResource &res = musics[music.index];
 
     if (Mix_PlayingMusic()) Mix_HaltMusic();
 
-    if (Mix_PlayMusic(it->second.music, loops) == -1) {
+    if (Mix_PlayMusic(res.music, loops) == -1) {
         log("Erro Mix_PlayMusic: ", Mix_GetError());
         return;
     }
-    currentMusicTag = tag;
+    currentMusicTag = res.tag;
 }
 
 void Engine::stopMusic()
@@ -374,46 +928,53 @@ void Engine::setMusicVolume(int volume)
     Mix_VolumeMusic(volume);
 }
 
-Object *Engine::createObject(int x, int y, int w, int h, string imageRef, int type, int depth)
+Object *Engine::createObject(int x, int y, int w, int h, TextureId image, int type, int depth)
 {
-    if (resources.find(TEXTURE_PREFIX + imageRef) != resources.end())
+    if (image.valid() && image.index < (int32_t)textures.size())
     {        
-        auto text = resources[TEXTURE_PREFIX + imageRef].texture;
-        int texW, texH;
-        SDL_QueryTexture(text, nullptr, nullptr, &texW, &texH);
-        if (w == 0) w = texW;
-        if (h == 0) h = texH;
+        const SDL_Point &size = textures[image.index].size;
+        if (w == 0) w = size.x;
+        if (h == 0) h = size.y;
     }
 
     if (x == this->RANDOM_X) x = rand() % getW();
     if (y == this->RANDOM_Y) y = rand() % getH();
 
-    auto obj = make_unique<Object>(x, y, w, h, imageRef, type, depth);
-    Object *ptr = obj.get();
-    objects.push_back(move(obj));
-    ordered_objects.push_back(ptr);
+    // reciclado do pool: vetores e strings voltam vazios, mas com a capacidade de antes
+    Object *ptr = objectPool.acquire();
+    ptr->reset(x, y, w, h, type, depth);
     ptr->setEngine(this);
+    ptr->addImage(image);
+    ptr->seq = nextObjectSeq++;
+    ptr->slot = (int)ordered_objects.size();
+    ordered_objects.push_back(ptr);
+    bucketInsert(ptr);
     return ptr;
 }
 
-Object *Engine::createObject(int x, int y, string imageRef)
+Object *Engine::createObject(int x, int y, int w, int h, const string &imageRef, int type, int depth)
+{
+    return createObject(x, y, w, h, findImage(imageRef), type, depth);
+}
+
+Object *Engine::createObject(int x, int y, const string &imageRef)
 {
-    return createObject(x, y, 0, 0, imageRef, 0, 0);
+    return createObject(x, y, 0, 0, findImage(imageRef), 0, 0);
 }
 
-Object *Engine::createObject(int x, int y, string imageRef, int type)
+Object *Engine::createObject(int x, int y, const string &imageRef, int type)
 {
-    return createObject(x, y, 0, 0, imageRef, type, type);
+    return createObject(x, y, 0, 0, findImage(imageRef), type, type);
 }
 
 Object *Engine::createObject(int x, int y, int type)
 {
-    return createObject(x, y, 0, 0, "", type, type);
+    return createObject(x, y, 0, 0, TextureId{}, type, type);
 }
 
 Object *Engine::createObject(int x, int y)
 {
-    return createObject(x, y, 0, 0, "", 0, 0);
+    return createObject(x, y, 0, 0, TextureId{}, 0, 0);
 }
 
 void Engine::centerXObject(Object *go)
@@ -438,12 +999,81 @@ void Engine::centerObject(Object *go)
     centerYObject(go);
 }
 
-void Engine::destroyObject(Object *obj)
+void Engine::bucketInsert(Object *obj)
+{
+    DepthBucket &bucket = depth_buckets[obj->getDepth()];
+
+    // objeto recém-criado é sempre o mais novo: vai pro fim
+    auto last = find_if(bucket.objs.rbegin(), bucket.objs.rend(), [](Object *o) { return o != nullptr; });
+    if (last == bucket.objs.rend() || (*last)->seq < obj->seq) {
+        obj->bucket_slot = (int)bucket.objs.size();
+        bucket.objs.push_back(obj);
+        return;
+    }
+
+    // veio de outro depth (setDepth, nunca durante o desenho): entra na posição da
+    // sua criação e renumera os que andaram uma casa
+    if (bucket.holes) bucketCompact(bucket);
+    auto it = upper_bound(bucket.objs.begin(), bucket.objs.end(), obj->seq,
+                          [](uint64_t seq, const Object *o) { return seq < o->seq; });
+    int i = int(bucket.objs.insert(it, obj) - bucket.objs.begin());
+    for (; i < (int)bucket.objs.size(); ++i) bucket.objs[i]->bucket_slot = i;
+}
+
+bool Engine::bucketRemove(Object *obj, int depth)
 {
-    ordered_objects.erase(remove(ordered_objects.begin(), ordered_objects.end(), obj), ordered_objects.end());
-    for (auto it = objects.begin(); it != objects.end(); ++it) {
-        if (it->get() == obj) { objects.erase(it); break; }
+    auto b = depth_buckets.find(depth);
+    if (b == depth_buckets.end()) return false;
+    DepthBucket &bucket = b->second;
+    const int i = obj->bucket_slot;
+    if (i < 0 || i >= (int)bucket.objs.size() || bucket.objs[i] != obj) return false;
+    // buraco (e não swap) pra manter a ordem de criação
+    bucket.objs[i] = nullptr;
+    obj->bucket_slot = -1;
+    bucket.holes++;
+    if (!drawing && bucket.holes * 2 > (int)bucket.objs.size()) bucketCompact(bucket);
+    return true;
+}
+
+void Engine::bucketCompact(DepthBucket &bucket)
+{
+    int n = 0;
+    for (Object *obj : bucket.objs) {
+        if (!obj) continue;
+        obj->bucket_slot = n;
+        bucket.objs[n++] = obj;
     }
+    bucket.objs.resize(n);
+    bucket.holes = 0;
+}
+
+void Engine::objectDepthChanged(Object *obj, int oldDepth)
+{
+    // durante o renderAll as listas estão sendo percorridas: aplica depois
+    if (drawing) {
+        pending_depth.push_back({ obj, oldDepth });
+        return;
+    }
+    if (bucketRemove(obj, oldDepth)) bucketInsert(obj);
+}
+
+void Engine::destroyObject(Object *obj)
+{
+    bucketRemove(obj, obj->getDepth());
+    // troca com o último: a ordem de ordered_objects não é a de desenho (essa fica nos baldes)
+    Object *last = ordered_objects.back();
+    ordered_objects[obj->slot] = last;
+    last->slot = obj->slot;
+    ordered_objects.pop_back();
+    retireObject(obj);
+}
+
+// Devolve ao pool: solta as imagens e os callbacks (que podem segurar capturas)
+void Engine::retireObject(Object *obj)
+{
+    for (TextureId id : obj->images) releaseImage(id);
+    obj->reset(0, 0, 0, 0);
+    objectPool.release(obj);
 }
 
 TTF_Font *Engine::getFont(const string &name, int size)
@@ -461,44 +1091,247 @@ TTF_Font *Engine::getFont(const string &name, int size)
     return f;
 }
 
-void Engine::drawText(const string &text, int x, int y, const string &fontName, int fontSize, SDL_Color color, bool centered)
+GlyphAtlas *Engine::getGlyphAtlas(const string &name, int size)
 {
-    if (text.empty()) return;
+    FontKey key{ name, size };
+    auto it = glyphAtlases.find(key);
+    if (it != glyphAtlases.end()) return it->second->isReady() ? it->second.get() : nullptr;
+
+    auto atlas = make_unique<GlyphAtlas>();
+    TTF_Font *font = getFont(name, size);
+    if (!font || !atlas->build(renderer, font)) {
+        log("Falha ao montar atlas de glifos: ", name);
+    }
+    GlyphAtlas *ptr = atlas.get();
+    glyphAtlases[key] = move(atlas);  // guarda mesmo se falhou, pra não tentar todo frame
+    return ptr->isReady() ? ptr : nullptr;
+}
+
+void Engine::drawText(const string &text, int x, int y, const string &fontName, int fontSize, SDL_Color color, bool centered,
+                      bool dynamic)
+{
+    if (!canRecord("drawText") || text.empty()) return;
+    DrawCmd &c = recording->add(DrawCmd::TEXT, recordDepth);
+    c.str  = recording->addString(text);
+    c.font = recording->addString(fontName);
+    c.size = fontSize;
+    c.x = x; c.y = y;
+    c.color   = Color{ color.r, color.g, color.b, color.a };
+    c.flag    = centered;
+    c.dynamic = dynamic;
+}
+
+void Engine::renderText(const DrawCmd &c, const DrawList &list)
+{
+    const string &text     = list.getString(c.str);
+    const string &fontName = list.getString(c.font);
+    const int fontSize = c.size;
+    const int x = c.x, y = c.y;
+    const bool centered = c.flag;
+    const SDL_Color color = toSDL(c.color);
 
     TTF_Font *font = getFont(fontName, fontSize);
     if (!font) return;
 
-    SDL_Surface *surf = TTF_RenderUTF8_Blended(font, text.c_str(), color);
-    if (!surf) return;
+    flushBatches();  // texto sai na ordem em que foi pedido
+
+    // texto dinâmico: quads do atlas de glifos num único SDL_RenderGeometry
+    if (c.dynamic) {
+        GlyphAtlas *atlas = getGlyphAtlas(fontName, fontSize);
+        if (atlas && atlas->covers(text)) {
+            int tw, th;
+            atlas->measure(text, tw, th);
+            float px = (float)x, py = (float)y;
+            if (centered) {
+                px = float(x - tw / 2);
+                py = float(y - th / 2);
+            }
+            textVerts.clear();
+            textIndices.clear();
+            atlas->appendQuads(text, px, py, color, textVerts, textIndices);
+            if (!textIndices.empty()) {
+                SDL_RenderGeometry(renderer, atlas->getTexture(), textVerts.data(), (int)textVerts.size(),
+                                   textIndices.data(), (int)textIndices.size());
+                frameStats.drawCalls++;
+            }
+            return;
+        }
+        // caractere fora do atlas: cai no cache de strings
+    }
 
-    SDL_Texture *tex = SDL_CreateTextureFromSurface(renderer, surf);
-    if (!tex) { SDL_FreeSurface(surf); return; }
+    const TextEntry *entry = textCache.get(renderer, font, fontName, fontSize, color, text);
+    if (!entry) return;
 
-    SDL_Rect dst{ x, y, surf->w, surf->h };
+    SDL_Rect dst{ x, y, entry->w, entry->h };
     if (centered) {
-        dst.x = x - surf->w / 2;
-        dst.y = y - surf->h / 2;
+        dst.x = x - entry->w / 2;
+        dst.y = y - entry->h / 2;
     }
 
-    SDL_RenderCopy(renderer, tex, nullptr, &dst);
+    SDL_RenderCopy(renderer, entry->texture, nullptr, &dst);
+    frameStats.drawCalls++;
+}
 
-    SDL_DestroyTexture(tex);
-    SDL_FreeSurface(surf);
+void Engine::setThreaded(bool on)
+{
+    if (on == threaded) return;
+    if (on) {
+        simQuit = false;
+        simRequested = false;
+        simThread = thread(&Engine::simLoop, this);
+        threaded = true;
+        return;
+    }
+    {
+        lock_guard<mutex> lock(simMutex);
+        simQuit = true;
+    }
+    simCv.notify_all();
+    if (simThread.joinable()) simThread.join();
+    threaded = false;
+}
+
+void Engine::simLoop()
+{
+    unique_lock<mutex> lock(simMutex);
+    while (true) {
+        simCv.wait(lock, [this]{ return simRequested || simQuit; });
+        if (simQuit) return;
+
+        lock.unlock();
+        runSteps();
+        recordFrame(drawLists[1 - frontList]);
+        lock.lock();
+
+        simRequested = false;
+        simCv.notify_all();
+    }
 }
 
 void Engine::calculateAndRender()
 {
-    calculateAll();
-    renderAll();
+    if (!threaded) {
+        pumpInput();
+        advanceClock();
+        runSteps();
+        renderAll();
+        return;
+    }
+
+    // eventos só podem ser lidos na thread da janela
+    pumpInput();
+    advanceClock();
+    {
+        lock_guard<mutex> lock(simMutex);
+        simRequested = true;
+    }
+    simCv.notify_all();
+
+    // enquanto a simulação grava o próximo frame, apresenta o que ficou pronto
+    presentFrame(drawLists[frontList]);
+
+    unique_lock<mutex> lock(simMutex);
+    simCv.wait(lock, [this]{ return !simRequested; });
+    frontList = 1 - frontList;
 }
 
+// Um passo avulso: quem chama controla o ritmo, então desenha sem interpolar
 void Engine::calculateAll()
+{
+    pumpInput();
+    simulate();
+    renderAlpha = 1.0f;
+}
+
+void Engine::runSteps()
+{
+    for (int i = 0; i < pendingSteps; ++i) {
+        repeatStep = i > 0;
+        simulate();
+    }
+    repeatStep = false;
+}
+
+void Engine::setSimulationRate(double hz)
+{
+    simStepMs = hz > 0.0 ? 1000.0 / hz : 0.0;
+    simAccumulator = 0.0;
+    simLastTick = 0;
+}
+
+void Engine::advanceClock()
+{
+    if (simStepMs <= 0.0) {
+        pendingSteps = 1;
+        renderAlpha  = 1.0f;
+        return;
+    }
+
+    const Uint64 now  = SDL_GetPerformanceCounter();
+    const double freq = double(SDL_GetPerformanceFrequency());
+    // primeiro frame conta como um passo
+    const double elapsed = simLastTick ? double(now - simLastTick) * 1000.0 / freq : simStepMs;
+    simLastTick = now;
+
+    // depois de uma travada (load, janela arrastada) não tenta recuperar tudo:
+    // no máximo maxStepsPerFrame passos, o resto do atraso é descartado
+    simAccumulator += min(elapsed, simStepMs * maxStepsPerFrame);
+    int steps = 0;
+    while (simAccumulator >= simStepMs && steps < maxStepsPerFrame) {
+        simAccumulator -= simStepMs;
+        ++steps;
+    }
+    if (simAccumulator >= simStepMs) simAccumulator = std::fmod(simAccumulator, simStepMs);
+
+    pendingSteps = steps;
+    renderAlpha  = float(simAccumulator / simStepMs);
+}
+
+// Objetos novos, estáticos ou que pularam mais de meia tela num passo
+// (wrap, reposicionamento) são desenhados na posição atual.
+float Engine::interpX(const Object *o) const
+{
+    const float x = o->getX();
+    if (renderAlpha >= 1.0f || o->isStatic() || !o->hasPrevPosition()) return x;
+    const float dx = x - o->getXPrev();
+    if (std::fabs(dx) > w * 0.5f) return x;
+    return x - dx * (1.0f - renderAlpha);
+}
+
+float Engine::interpY(const Object *o) const
+{
+    const float y = o->getY();
+    if (renderAlpha >= 1.0f || o->isStatic() || !o->hasPrevPosition()) return y;
+    const float dy = y - o->getYPrev();
+    if (std::fabs(dy) > h * 0.5f) return y;
+    return y - dy * (1.0f - renderAlpha);
+}
+
+void Engine::pumpInput()
 {
     inputBeginFrame();
     if (quitRequested() || keyPressed(SDL_SCANCODE_ESCAPE)) running = false;
 
-    auto snapshot = ordered_objects;  
-    for (Object *obj : snapshot)  obj->calculate();
+    // O driver descartou o que estava nas render targets: camadas e halos
+    // assados viram lixo. O bloom é redesenhado a cada frame e não guarda nada.
+    // A simulação está parada aqui, então dá pra mexer nos caches direto.
+    if (inputSys.renderReset()) {
+        layerCache.invalidateAll();
+        glowCache.clear();
+        layerResync = true;   // as camadas voltam a ser montadas a partir dos membros
+    }
+    layersOn = layerCache.isSupported();
+}
+
+void Engine::simulate()
+{
+    if (onStep) onStep();
+
+    particles.beginStep();
+    stepObjects.assign(ordered_objects.begin(), ordered_objects.end());   // callbacks podem criar/destruir
+    for (Object *obj : stepObjects) obj->calculate();
+    particles.update();
+    starfield.update();
     
     processCollisions();
     flushDestroyQueue();
@@ -506,25 +1339,294 @@ void Engine::calculateAll()
 
 void Engine::renderAll()
 {
-    SDL_SetRenderDrawColor(renderer, 0, 0, 0, 255);
-    SDL_RenderClear(renderer);
+    recordFrame(drawLists[1 - frontList]);
+    frontList = 1 - frontList;
+    presentFrame(drawLists[frontList]);
+}
+
+// Percorre os objetos e grava o que eles desenham. Roda na simulação: não toca no renderer.
+void Engine::recordFrame(DrawList &list)
+{
+    list.clear();
+    recording = &list;
+    if (layerResync.exchange(false)) recordedLayers.clear();
+    const bool layers = layersOn;
+    const bool withBloom = bloomOn;
+
+    // depth: maior primeiro (menor fica no topo, pois desenha por último);
+    // as listas já estão na ordem, sem sort por frame. O starfield entra antes
+    // dos objetos do mesmo depth (fica por baixo, como as estrelas-objeto criadas
+    // primeiro); os emissores de partículas entram depois deles.
+    const vector<ParticleEmitter*> &emitters = particles.byDepth();
+    size_t nextEmitter = 0;
+    bool starsPending = true;
+    auto recordAbove = [&](const int *depth) {   // nullptr = todo o resto
+        if (starsPending && (!depth || starfield.depth >= *depth)) {
+            recordStarfield();
+            starsPending = false;
+        }
+        while (nextEmitter < emitters.size() && (!depth || emitters[nextEmitter]->depth > *depth))
+            recordEmitter(*emitters[nextEmitter++]);
+    };
+    drawing = true;
+    for (auto &[depth, bucket] : depth_buckets) {
+        const vector<Object*> &objs = bucket.objs;   // pode ter buracos (nullptr)
+        recordAbove(&depth);
+        // objetos estáticos do depth: uma cópia da camada; os membros só são
+        // gravados (e a camada remontada) quando a assinatura muda
+        uint64_t signature = 1469598103934665603ULL;
+        int members = 0;
+        if (layers) {
+            for (Object *obj : objs) {
+                if (!obj || !obj->isVisible() || !Engine_layerMember(obj, withBloom)) continue;
+                Engine_mix(signature, Engine_layerSignature(obj));
+                ++members;
+            }
+        }
+        const bool useLayer = members > 0;
+        if (useLayer) {
+            auto known = recordedLayers.find(depth);
+            const bool rebuild = known == recordedLayers.end() || known->second != signature;
+            DrawCmd &begin = list.add(DrawCmd::LAYER_BEGIN, depth);
+            begin.signature = signature;
+            begin.flag      = rebuild;
+            if (rebuild) {
+                for (Object *obj : objs) {
+                    if (!obj || !obj->isVisible() || !Engine_layerMember(obj, withBloom)) continue;
+                    if (culling && isOffscreen(obj)) continue;
+                    drawObject(obj);
+                }
+                recordedLayers[depth] = signature;
+            }
+            list.add(DrawCmd::LAYER_END, depth);
+        }
+
+        for (size_t i = 0; i < objs.size(); ++i) {
+            Object *obj = objs[i];
+            if (!obj || !obj->isVisible()) continue;
+            if (useLayer && Engine_layerMember(obj, withBloom)) continue;
+            if (culling && isOffscreen(obj)) {
+                list.objectsCulled++;
+                continue;
+            }
+            list.objectsDrawn++;
+            drawObject(obj);
+        }
+    }
+    recordAbove(nullptr);
+    drawing = false;
+    for (auto &[obj, oldDepth] : pending_depth) objectDepthChanged(obj, oldDepth);
+    pending_depth.clear();
+    recording = nullptr;
+}
+
+// Grava as partículas vivas do emissor como uma sequência SPRITES
+void Engine::recordEmitter(ParticleEmitter &e)
+{
+    if (!e.visible || e.size() == 0) return;
+
+    DrawList &list = *recording;
+    const uint32_t first = (uint32_t)list.sprites.size();
+    const float back = 1.0f - renderAlpha;   // interpolação: volta parte do último passo
+    const float pad  = e.fx.glowRadius > 0 ? float(e.fx.glowRadius) : 0.0f;
+
+    float ox = e.originX, oy = e.originY;
+    if (std::fabs(ox - e.prevOriginX) <= w * 0.5f && std::fabs(oy - e.prevOriginY) <= h * 0.5f) {
+        ox -= (ox - e.prevOriginX) * back;
+        oy -= (oy - e.prevOriginY) * back;
+    }
+
+    for (size_t i = 0, n = e.size(); i < n; ++i) {
+        const float cx = ox + e.x[i] - e.vx[i] * back;
+        const float cy = oy + e.y[i] - e.vy[i] * back;
+        const float pw = e.w[i], ph = e.h[i];
+        if (culling) {
+            // círculo que contém o quad em qualquer ângulo
+            const float r = 0.71f * max(pw, ph) + pad;
+            if (cx + r <= 0.0f || cx - r >= float(w) || cy + r <= 0.0f || cy - r >= float(h)) continue;
+        }
+        Color tint = e.tint[i];
+        if (e.fadeOut) tint.a = Uint8(tint.a * e.life[i] / e.lifeStart[i]);
+        list.sprites.push_back(DrawSprite{ e.frame[i], int(cx - pw * 0.5f), int(cy - ph * 0.5f), int(pw), int(ph),
+                                           e.angle[i], tint });
+    }
 
-    // depth: maior primeiro (menor fica no topo, pois desenha por último)
-    stable_sort(ordered_objects.begin(), ordered_objects.end(),
-        [](Object *a, Object *b){ return a->getDepth() > b->getDepth();});
+    const uint32_t count = (uint32_t)list.sprites.size() - first;
+    if (count == 0) return;
+    DrawCmd &c = list.add(DrawCmd::SPRITES, e.depth);
+    c.fx    = e.fx;
+    c.first = first;
+    c.count = count;
+    list.particles += (int)count;
+}
 
-    for (Object *obj : ordered_objects) {
-        if (obj->isVisible()) drawObject(obj);
+// Todas as faixas numa sequência SPRITES (mesma imagem: um lote só no batch)
+void Engine::recordStarfield()
+{
+    if (!starfield.visible || starfield.size() == 0) return;
+
+    DrawList &list = *recording;
+    const uint32_t first = (uint32_t)list.sprites.size();
+    const float back = 1.0f - renderAlpha;
+    for (const StarBand &b : starfield.getBands()) {
+        const float left = b.w * 0.5f, top = b.h * 0.5f + b.speed * back;
+        for (size_t i = 0, n = b.y.size(); i < n; ++i)
+            list.sprites.push_back(DrawSprite{ b.image, int(b.x[i] - left), int(b.y[i] - top), b.w, b.h, 0.0f, b.tint });
     }
 
+    DrawCmd &c = list.add(DrawCmd::SPRITES, starfield.depth);
+    c.first = first;
+    c.count = (uint32_t)list.sprites.size() - first;
+}
+
+// Desenha uma lista gravada e apresenta. Só na thread principal.
+void Engine::presentFrame(const DrawList &list)
+{
+    ++frameIndex;
+    uploadPrefetched();
+    resolveImages(list);
+    enforceBudget();
+
+    if (backend == RenderBackend::Software) {
+        softRenderer.render(list, textures, [this](const string &name, int size) { return getFont(name, size); });
+        softRenderer.present();
+
+        const SoftStats &soft = softRenderer.getStats();
+        frameStats = RenderStats{};
+        frameStats.objectsDrawn  = list.objectsDrawn;
+        frameStats.objectsCulled = list.objectsCulled;
+        frameStats.particles     = list.particles;
+        frameStats.drawCalls     = soft.ops;
+        frameStats.pixels        = soft.pixels;
+        frameStats.rasterMs      = soft.rasterMs;
+        lastStats = frameStats;
+
+        pacer.wait();
+        return;
+    }
+
+    renderState.drawColor(0, 0, 0, 255);
+    SDL_RenderClear(renderer);
+    frameStats = RenderStats{};
+    frameStats.objectsDrawn  = list.objectsDrawn;
+    frameStats.objectsCulled = list.objectsCulled;
+    frameStats.particles     = list.particles;
+
+    replay(list, 0, list.cmds.size());
+    flushBatches();
+
+    if (!bloomSprites.empty()) {
+        if (bloom.begin()) {
+            for (const SpriteCmd &cmd : bloomSprites) spriteBatch.add(cmd);
+            flushSprites();
+            frameStats.drawCalls += bloom.composite();
+        }
+        bloomSprites.clear();
+    }
+
+    frameStats.sprites = spriteBatch.getSprites();
+    layerCache.resetStats();
+    spriteBatch.resetStats();
+    frameStats.stateChanges        = renderState.getApplied();
+    frameStats.stateChangesSkipped = renderState.getSkipped();
+    renderState.resetStats();
+    lastStats = frameStats;
+
     SDL_RenderPresent(renderer);
-    SDL_Delay(16);    
+    pacer.wait();
+}
+
+void Engine::replay(const DrawList &list, size_t begin, size_t end)
+{
+    for (size_t i = begin; i < end; ++i) {
+        const DrawCmd &c = list.cmds[i];
+        switch (c.type) {
+            case DrawCmd::IMAGE:
+                renderImage(c);
+                break;
+            case DrawCmd::SPRITES:
+                renderSprites(c, list);
+                break;
+            case DrawCmd::TEXT:
+                renderText(c, list);
+                break;
+            case DrawCmd::RECT:
+                flushSprites();
+                if (c.flag) primBatch.fillRect(c.x, c.y, c.w, c.h, toSDL(c.color));
+                else        primBatch.rect(c.x, c.y, c.w, c.h, toSDL(c.color));
+                break;
+            case DrawCmd::LINE:
+                flushSprites();
+                primBatch.line(c.x, c.y, c.x2, c.y2, toSDL(c.color));
+                break;
+            case DrawCmd::CIRCLE:
+                flushSprites();
+                if (c.flag) primBatch.fillCircle(c.x, c.y, c.size, toSDL(c.color));
+                else        primBatch.circle(c.x, c.y, c.size, toSDL(c.color));
+                break;
+            case DrawCmd::POINT:
+                flushSprites();
+                primBatch.point(c.x, c.y, toSDL(c.color));
+                break;
+            case DrawCmd::POLYGON:
+                flushSprites();
+                primBatch.polyline(list.points.data() + c.first, c.count, c.flag, toSDL(c.color));
+                break;
+            case DrawCmd::LAYER_BEGIN: {
+                size_t last = i + 1;
+                while (last < end && list.cmds[last].type != DrawCmd::LAYER_END) ++last;
+
+                StaticLayer *layer = layerCache.get(c.depth);
+                if (layer && c.flag && !rebuildLayer(*layer, list, i + 1, last, c.signature))
+                    layer = nullptr;
+                if (layer && (!layer->valid || layer->signature != c.signature))
+                    layer = nullptr;
+
+                if (layer) {
+                    SpriteCmd cmd;
+                    cmd.texture = layer->texture;
+                    cmd.src     = SDL_Rect{ 0, 0, w, h };
+                    cmd.dst     = SDL_FRect{ 0, 0, float(w), float(h) };
+                    cmd.blend   = layerCache.getCompositeBlend();
+                    cmd.depth   = c.depth;
+                    cmd.layer   = -1;
+                    flushPrimitives();
+                    spriteBatch.add(cmd);
+                    frameStats.staticLayers++;
+                } else if (c.flag) {
+                    replay(list, i + 1, last);   // sem camada: desenha os membros direto
+                } else {
+                    layerResync = true;          // membros não gravados: a simulação regrava
+                }
+                i = last;
+                break;
+            }
+            case DrawCmd::LAYER_END:
+                break;
+        }
+    }
+}
+
+bool Engine::rebuildLayer(StaticLayer &layer, const DrawList &list, size_t begin, size_t end, uint64_t signature)
+{
+    flushBatches();  // o que já está nos batches vai pro alvo atual, não pra camada
+    if (!layerCache.begin(layer)) return false;
+    replay(list, begin, end);
+    flushBatches();
+    layerCache.end(layer, signature);
+    frameStats.layerRebuilds++;
+    return true;
 }
 
 void Engine::clear()
 {
+    particles.clear();
+    starfield.clear();
+    depth_buckets.clear();
+    pending_depth.clear();
+    destroy_queue.clear();   // os endereços voltam pro pool e podem ser reusados
+    for (Object *obj : ordered_objects) retireObject(obj);
     ordered_objects.clear();
-    objects.clear();
 }
 
 int Engine::getW() { return w; }
@@ -662,11 +1764,10 @@ int Engine::countObjectTags(int tag)
 }
 
 void Engine::requestDestroy(Object* obj) {
-    if (!obj) return;
-    if (find(destroy_queue.begin(), destroy_queue.end(), obj) == destroy_queue.end()) {
-        obj->setDefunct(true);
-        destroy_queue.push_back(obj);
-    }
+    if (!obj || obj->queued) return;
+    obj->queued = true;
+    obj->setDefunct(true);
+    destroy_queue.push_back(obj);
 }
 
 void Engine::requestDestroyAllTypeBut(int type) {
@@ -704,11 +1805,7 @@ void Engine::requestDestroyByTag(int tag)
 void Engine::flushDestroyQueue() {
     // destrói de fato (fora de colisão/desenho)
     for (Object* obj : destroy_queue) {
-        if (!obj) continue;
-        auto it = find(ordered_objects.begin(), ordered_objects.end(), obj);
-        if (it != ordered_objects.end()) {
-            destroyObject(obj);
-        }
+        if (obj && obj->slot >= 0) destroyObject(obj);
     }
     destroy_queue.clear();
 }
@@ -721,74 +1818,42 @@ int Engine::randRangeInt(int x, int y) {
 
 Object* Engine::getObject(int i)
 {
-    return objects[i].get();
+    return ordered_objects[i];
 }
 
-// --- desenho (preservando cor do renderer)
+// --- desenho: primitivas são gravadas e, no replay, vão pro PrimitiveBatch
 void Engine::drawRect(int x, int y, int w, int h, const Color& c, bool filled)
 {
-    Uint8 oldR, oldG, oldB, oldA;
-    SDL_GetRenderDrawColor(renderer, &oldR, &oldG, &oldB, &oldA);
-
-    SDL_SetRenderDrawColor(renderer, c.r, c.g, c.b, c.a);
-    SDL_Rect rect{ x, y, w, h };
-    if (filled) SDL_RenderFillRect(renderer, &rect);
-    else        SDL_RenderDrawRect(renderer, &rect);
-
-    SDL_SetRenderDrawColor(renderer, oldR, oldG, oldB, oldA);
+    if (!canRecord("drawRect")) return;
+    DrawCmd &d = recording->add(DrawCmd::RECT, recordDepth);
+    d.x = x; d.y = y; d.w = w; d.h = h;
+    d.color = c;
+    d.flag  = filled;
 }
 
 void Engine::drawLine(int x1, int y1, int x2, int y2, const Color& c)
 {
-    Uint8 oldR, oldG, oldB, oldA;
-    SDL_GetRenderDrawColor(renderer, &oldR, &oldG, &oldB, &oldA);
-
-    SDL_SetRenderDrawColor(renderer, c.r, c.g, c.b, c.a);
-    SDL_RenderDrawLine(renderer, x1, y1, x2, y2);
-
-    SDL_SetRenderDrawColor(renderer, oldR, oldG, oldB, oldA);
+    if (!canRecord("drawLine")) return;
+    DrawCmd &d = recording->add(DrawCmd::LINE, recordDepth);
+    d.x = x1; d.y = y1; d.x2 = x2; d.y2 = y2;
+    d.color = c;
 }
 
 void Engine::drawCircle(int cx, int cy, int radius, const Color& c, bool filled)
 {
-    Uint8 oldR, oldG, oldB, oldA;
-    SDL_GetRenderDrawColor(renderer, &oldR, &oldG, &oldB, &oldA);
-
-    SDL_SetRenderDrawColor(renderer, c.r, c.g, c.b, c.a);
-
-    if (filled) {
-        for (int dy = -radius; dy <= radius; dy++) {
-            int dx = (int)sqrt(radius * radius - dy * dy);
-            SDL_RenderDrawLine(renderer, cx - dx, cy + dy, cx + dx, cy + dy);
-        }
-    } else {
-        int x = radius, y = 0, err = 0;
-        while (x >= y) {
-            SDL_RenderDrawPoint(renderer, cx + x, cy + y);
-            SDL_RenderDrawPoint(renderer, cx + y, cy + x);
-            SDL_RenderDrawPoint(renderer, cx - y, cy + x);
-            SDL_RenderDrawPoint(renderer, cx - x, cy + y);
-            SDL_RenderDrawPoint(renderer, cx - x, cy - y);
-            SDL_RenderDrawPoint(renderer, cx - y, cy - x);
-            SDL_RenderDrawPoint(renderer, cx + y, cy - x);
-            SDL_RenderDrawPoint(renderer, cx + x, cy - y);
-            if (err <= 0) { y += 1; err += 2*y + 1; }
-            if (err > 0)  { x -= 1; err -= 2*x + 1; }
-        }
-    }
-
-    SDL_SetRenderDrawColor(renderer, oldR, oldG, oldB, oldA);
+    if (!canRecord("drawCircle")) return;
+    DrawCmd &d = recording->add(DrawCmd::CIRCLE, recordDepth);
+    d.x = cx; d.y = cy; d.size = radius;
+    d.color = c;
+    d.flag  = filled;
 }
 
 void Engine::drawPoint(int x, int y, const Color& c)
 {
-    Uint8 oldR, oldG, oldB, oldA;
-    SDL_GetRenderDrawColor(renderer, &oldR, &oldG, &oldB, &oldA);
-
-    SDL_SetRenderDrawColor(renderer, c.r, c.g, c.b, c.a);
-    SDL_RenderDrawPoint(renderer, x, y);
-
-    SDL_SetRenderDrawColor(renderer, oldR, oldG, oldB, oldA);
+    if (!canRecord("drawPoint")) return;
+    DrawCmd &d = recording->add(DrawCmd::POINT, recordDepth);
+    d.x = x; d.y = y;
+    d.color = c;
 }
 
 void Engine::drawLineRect(int x, int y, int w, int h, const Color& c)
@@ -807,11 +1872,13 @@ void Engine::drawGrid(int cellW, int cellH, const Color& c)
 
 void Engine::drawPolygon(const vector<pair<int,int>>& pts, const Color& c, bool closed)
 {
-    if (pts.size() < 2) return;
-    for (size_t i = 0; i < pts.size()-1; i++)
-        drawLine(pts[i].first, pts[i].second, pts[i+1].first, pts[i+1].second, c);
-    if (closed)
-        drawLine(pts.back().first, pts.back().second, pts[0].first, pts[0].second, c);
+    if (!canRecord("drawPolygon") || pts.size() < 2) return;
+    DrawCmd &d = recording->add(DrawCmd::POLYGON, recordDepth);
+    d.first = (uint32_t)recording->points.size();
+    d.count = (uint32_t)pts.size();
+    d.color = c;
+    d.flag  = closed;
+    recording->points.insert(recording->points.end(), pts.begin(), pts.end());
 }
 
 void Engine::drawCross(int cx, int cy, int size, const Color& c)
@@ -819,4 +1886,3 @@ void Engine::drawCross(int cx, int cy, int size, const Color& c)
     drawLine(cx - size, cy, cx + size, cy, c);
     drawLine(cx, cy - size, cx, cy + size, c);
 }
-
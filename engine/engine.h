@@ -12,12 +12,34 @@
 #include <iostream>
 #include <cstdarg>
 #include <unordered_map>
+#include <map>
 #include <random>
 #include <array>
 #include <utility>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <atomic>
 #include "resources.h"
 #include "gameobject.h"
 #include "input.h"
+#include "textcache.h"
+#include "glyphatlas.h"
+#include "atlas.h"
+#include "renderstate.h"
+#include "spritebatch.h"
+#include "primitivebatch.h"
+#include "glowcache.h"
+#include "layercache.h"
+#include "drawlist.h"
+#include "softrenderer.h"
+#include "framepacer.h"
+#include "bloom.h"
+#include "particles.h"
+#include "starfield.h"
+#include "imageloader.h"
+#include "mipmap.h"
+#include "objectpool.h"
 
 struct FontKey {
     string name;
@@ -30,11 +52,47 @@ struct FontKeyHash {
     }
 };
 
+// Contadores do último frame desenhado
+struct RenderStats {
+    int drawCalls = 0;   // chamadas de desenho enviadas ao SDL
+    int sprites   = 0;   // sprites que passaram pelo batch
+    int stateChanges = 0;        // blend/cor/alpha realmente enviados ao SDL
+    int stateChangesSkipped = 0; // redundantes, evitados pelo RenderState
+    int objectsDrawn  = 0;       // objetos visíveis que passaram pelo drawObject
+    int objectsCulled = 0;       // visíveis, mas fora da tela (nem callbacks rodaram)
+    int staticLayers  = 0;       // camadas estáticas compostas (uma cópia cada)
+    int layerRebuilds = 0;       // camadas remontadas porque um membro mudou
+    int particles     = 0;       // partículas desenhadas
+    uint64_t pixels   = 0;       // só software: pixels que passaram pelos kernels de blend
+    double rasterMs   = 0.0;     // só software: tempo de rasterização do frame
+};
+
+// Um recurso no relatório de memória
+struct ResourceUsage {
+    string tag;
+    GameResource::Type type = GameResource::NONE;
+    size_t bytes   = 0;        // pixels/amostras residentes que a entrada é dona
+    int    refs    = 0;        // objetos vivos usando (só imagens)
+    bool   resident = false;
+    bool   evictable = false;  // imagem avulsa com arquivo: pode sair e voltar sob demanda
+    uint64_t lastUsed = 0;     // frame do último desenho
+};
+
+struct MemoryReport {
+    size_t imageBytes = 0;     // texturas/superfícies avulsas
+    size_t atlasBytes = 0;     // páginas do atlas (fixas, não saem)
+    size_t soundBytes = 0;     // efeitos decodificados (músicas são lidas em streaming)
+    size_t budget     = 0;     // 0 = sem limite
+    uint64_t evictions = 0;    // imagens despejadas desde o início
+    vector<ResourceUsage> items;
+};
+
+// GPU: SDL_Renderer acelerado. Software: rasterizador de CPU (SoftRenderer),
+// para máquinas sem aceleração; também escolhido com ENGINE_RENDERER=software.
+enum class RenderBackend { GPU, Software };
+
 class Engine {
 private:
-    static constexpr const char *TEXTURE_PREFIX = "TEX";
-    static constexpr const char *SOUND_PREFIX   = "SND";
-    static constexpr const char *MUSIC_PREFIX   = "MUS";
     string currentMusicTag;
 
     Input inputSys;
@@ -42,25 +100,153 @@ private:
     int w, h;
     SDL_Window   *window   = nullptr;
     SDL_Renderer *renderer = nullptr;
-    unordered_map<string, GameResource> resources;
+    RenderBackend backend  = RenderBackend::GPU;
+    SoftRenderer  softRenderer;      // só no backend Software
+    // recursos em vetores densos (o handle é o índice); o nome só é usado pra resolver
+    vector<GameResource> textures;
+    vector<GameResource> sounds;
+    vector<GameResource> musics;
+    unordered_map<string, TextureId> textureIds;
+    unordered_map<string, SoundId>   soundIds;
+    unordered_map<string, MusicId>   musicIds;
+    TextureAtlas atlas;              // páginas onde loadImage empacota as imagens
+
+    // imagens registradas sem carregar: resolvidas na thread principal antes do desenho
+    ImageLoader loader;              // decodifica os pedidos de prefetch em segundo plano
+    vector<LoadedImage> loadedImages;
+    mutex prefetchMutex;
+    vector<int32_t> prefetchQueue;   // prefetchImage pode vir da thread da simulação
+    int lazyImages = 0;              // entradas ainda sem pixels (0 = nada a resolver)
+
+    // orçamento de memória de imagens: acima dele, imagens avulsas sem objetos
+    // e fora do frame saem (menos usada primeiro) e voltam pelo arquivo no próximo uso
+    size_t imageBudget = 0;          // 0 = sem limite
+    uint64_t frameIndex = 0;         // conta os presentFrame; carimba lastUsed
+    uint64_t evictions = 0;
 
     // controle de objetos
-    vector<unique_ptr<Object>> objects;
+    ObjectPool objectPool;           // dono dos objetos (blocos contíguos, reciclados)
     vector<Object*> ordered_objects;
+    uint64_t nextObjectSeq = 0;      // Object::seq do próximo criado
+    vector<Object*> stepObjects;     // cópia da lista pro passo (buffer reaproveitado)
+    // listas de desenho por depth (maior primeiro), mantidas na criação/destruição/setDepth;
+    // dentro do mesmo depth fica a ordem de criação (Object::seq)
+    // balde: remoção deixa um buraco (nullptr) pra não deslocar a ordem no meio
+    // do desenho; compacta quando os buracos passam da metade
+    struct DepthBucket {
+        vector<Object*> objs;
+        int holes = 0;
+    };
+    map<int, DepthBucket, greater<int>> depth_buckets;
+    vector<pair<Object*, int>> pending_depth;  // setDepth durante o desenho (objeto, depth antigo)
+    bool drawing = false;
+    bool culling = true;
+
+    // Frame gravado em DrawList (simulação) e desenhado depois (thread principal).
+    // Com setThreaded(true) a simulação do frame N+1 roda enquanto o N é apresentado.
+    DrawList  drawLists[2];
+    int       frontList = 0;            // lista pronta pra apresentar
+    DrawList *recording = nullptr;      // lista sendo gravada (só dentro do recordFrame)
+    int       recordDepth = 0;
+    atomic<bool> warnedOffFrameDraw{false};   // já avisou de um draw* fora da gravação
+    unordered_map<int, uint64_t> recordedLayers;   // depth -> assinatura cujos membros já foram gravados
+    atomic<bool> layerResync{false};    // a camada se perdeu: regravar os membros
+    bool      layersOn = true;          // layerCache.isSupported() do frame; tirado no pumpInput,
+                                        // antes de acordar a simulação (o LayerCache é só da thread principal)
+
+    // Passo fixo: cada frame roda quantos passos de simStepMs couberem no tempo
+    // que passou (acumulador) e desenha interpolando entre o passo anterior e o atual
+    double simStepMs = 1000.0 / 60.0;   // 0 = um passo por frame, sem interpolação
+    double simAccumulator = 0.0;
+    Uint64 simLastTick = 0;
+    int    maxStepsPerFrame = 5;        // limite quando o frame atrasa muito
+    int    pendingSteps = 1;            // passos do frame sendo simulado
+    float  renderAlpha = 1.0f;          // fração do próximo passo já decorrida (desenho)
+    bool   repeatStep = false;          // 2º passo em diante do frame: transições de input já vistas
+
+    bool threaded = false;
+    thread simThread;
+    mutex simMutex;
+    condition_variable simCv;
+    bool simRequested = false;
+    bool simQuit = false;
     unordered_map<FontKey, TTF_Font*, FontKeyHash> fontCache;
+    TextCache textCache;             // texturas de texto já renderizadas (LRU)
+    unordered_map<FontKey, unique_ptr<GlyphAtlas>, FontKeyHash> glyphAtlases;
+    vector<SDL_Vertex> textVerts;    // buffers reaproveitados do texto por glifos
+    vector<int>        textIndices;
+
+    RenderState renderState;         // evita SDL_Set* redundantes
+    SpriteBatch spriteBatch;         // sprites do frame, enviados em lotes
+    PrimitiveBatch primBatch;        // retângulos/linhas/círculos/pontos, enviados em lotes
+    GlowCache   glowCache;           // halos de glow pré-renderizados
+    LayerCache  layerCache;          // objetos estáticos já compostos, por depth
+    Bloom       bloom;               // pós-processo no lugar dos halos por sprite
+    atomic<bool> bloomOn{false};     // lido pela simulação ao montar as camadas
+    vector<SpriteCmd> bloomSprites;  // emissivos do frame, já na escala do alvo do bloom
+    int         currentDepth = 0;    // depth do comando sendo desenhado (replay)
+    RenderStats frameStats;          // frame em andamento
+    RenderStats lastStats;           // último frame completo
+    FramePacer  pacer;               // espera do fim do frame (substitui o SDL_Delay fixo)
+    PaceMode    paceRequest = PaceMode::Fixed;
     
     vector<Object*> destroy_queue;    
 
+    ParticleSystem particles;        // explosões, rastros: SoA, sem Object
+    Starfield      starfield;        // fundo de estrelas em faixas de velocidade
+
     bool checkCollision(const Object &a, const Object &b);
     void destroyObject(Object *obj);
     void flushDestroyQueue();  
+    bool isOffscreen(const Object *obj) const;
+    bool rebuildLayer(StaticLayer &layer, const DrawList &list, size_t begin, size_t end, uint64_t signature);
+
+    void pumpInput();
+    void advanceClock();             // acumula o tempo do frame -> pendingSteps, renderAlpha
+    void runSteps();                 // os pendingSteps passos do frame
+    void simulate();
+    void simLoop();
+    void recordFrame(DrawList &list);
+    bool canRecord(const char *call);   // recording != nullptr; avisa uma vez quando não
+    void presentFrame(const DrawList &list);
+    void uploadPrefetched();         // pedidos de prefetch -> loader; decodificados -> textura
+    void resolveImages(const DrawList &list);
+    bool ensureResident(int32_t index);
+    void adoptImage(int32_t index, const vector<SDL_Surface*> &levels);
+    void failImage(int32_t index);   // não carregou: desiste dela e das partes
+    // cadeia de mips -> atlas, texturas avulsas ou pixels de CPU
+    GameResource makeImage(const vector<SDL_Surface*> &levels, SDL_Point size, bool packed = true);
+    bool isEvictable(const GameResource &res) const;
+    void evictImage(int32_t index);
+    void enforceBudget();
+    size_t residentImageBytes() const;
+    void replay(const DrawList &list, size_t begin, size_t end);
+    void renderImage(const DrawCmd &c);
+    void renderSprites(const DrawCmd &c, const DrawList &list);
+    void submitSprite(TextureId image, int x, int y, int w, int h, float angle, const FxParams &fx, int depth);
+    void recordEmitter(ParticleEmitter &e);
+    void recordStarfield();
+    void renderText(const DrawCmd &c, const DrawList &list);
+    void applyPacing();
+    void retireObject(Object *obj);
+    void bucketInsert(Object *obj);
+    bool bucketRemove(Object *obj, int depth);
+    void bucketCompact(DepthBucket &bucket);
+    void flushSprites();             // desenha o que está no batch de sprites
+    void flushPrimitives();          // desenha o que está no batch de primitivas
+    void flushBatches();             // os dois (antes de desenho imediato / troca de alvo)
+
+    static void freeResource(GameResource &res);
+    template <typename Id>
+    Id storeResource(vector<GameResource> &store, unordered_map<string, Id> &ids,
+                     const string &tag, GameResource res);
 
     static inline mt19937 &rng() {
         static thread_local mt19937 gen{ random_device{}() };
         return gen;
     }
 
-    inline void inputBeginFrame()  { inputSys.beginFrame(); }
+    inline void inputBeginFrame()  { inputSys.beginFrame(pendingSteps == 0); }
 
 public:
     Engine() = default;
@@ -71,6 +257,9 @@ public:
 
     bool running;
 
+    // Lógica do jogo que roda a cada passo da simulação (antes dos objetos)
+    function<void()> onStep;
+
 // --- Wrappers de input (o jogo só chama Engine) ---
     // --- Helpers de AABB (funcionam com x/y sendo centro ou canto)
     static inline int objLeft  (const Object* o) { return o->isCentered() ? int(o->getX() - o->getW()/2) : int(o->getX()); }
@@ -78,16 +267,22 @@ public:
     static inline int objRight (const Object* o) { return objLeft(o) + o->getW(); }
     static inline int objBottom(const Object* o) { return objTop(o)  + o->getH(); }
 
+    // Posição de desenho: interpolada entre o passo anterior e o atual
+    float interpX(const Object *o) const;
+    float interpY(const Object *o) const;
+    inline int drawLeft(const Object* o) const { return o->isCentered() ? int(interpX(o) - o->getW()/2) : int(interpX(o)); }
+    inline int drawTop (const Object* o) const { return o->isCentered() ? int(interpY(o) - o->getH()/2) : int(interpY(o)); }
+
     inline bool quitRequested()                  { return inputSys.quitRequested(); }
     inline bool keyHeld(SDL_Scancode sc)         { return inputSys.keyHeld(sc); }
-    inline bool keyPressed(SDL_Scancode sc)      { return inputSys.keyPressed(sc); }
-    inline bool keyReleased(SDL_Scancode sc)     { return inputSys.keyReleased(sc); }
+    inline bool keyPressed(SDL_Scancode sc)      { return !repeatStep && inputSys.keyPressed(sc); }
+    inline bool keyReleased(SDL_Scancode sc)     { return !repeatStep && inputSys.keyReleased(sc); }
 
     inline bool  openGamepad(int index=0)                           { return inputSys.openGamepad(index); }
     inline void  closeGamepads()                                    { inputSys.closeGamepads(); }
     inline bool  padHeld(SDL_GameControllerButton btn, int i=0)     { return inputSys.padHeld(btn,i); }
-    inline bool  padPressed(SDL_GameControllerButton btn, int i=0)  { return inputSys.padPressed(btn,i); }
-    inline bool  padReleased(SDL_GameControllerButton btn, int i=0) { return inputSys.padReleased(btn,i); }
+    inline bool  padPressed(SDL_GameControllerButton btn, int i=0)  { return !repeatStep && inputSys.padPressed(btn,i); }
+    inline bool  padReleased(SDL_GameControllerButton btn, int i=0) { return !repeatStep && inputSys.padReleased(btn,i); }
     inline Sint16 padAxis(SDL_GameControllerAxis axis, int i=0)     { return inputSys.padAxis(axis,i); }
 
     void requestDestroyAll();                // destroi todos
@@ -123,20 +318,61 @@ public:
 
     bool init(const char *title, int largura, int altura);
 
-    void loadImage(string path, string tag);
-    void splitImage(string baseImageRef, int numberOfParts, string baseTag);
+    // Recarregar uma tag já existente reaproveita o mesmo handle.
+    // Cada imagem ganha uma cadeia de mips (box 2x2 na CPU) e o desenho usa o
+    // nível mais perto do tamanho na tela. maxScale: maior escala em que a imagem
+    // aparece; os níveis acima dela nem vão pra VRAM (o tamanho nominal não muda)
+    TextureId loadImage(const string &path, const string &tag, float maxScale = 1.0f);
+    inline int atlasPageCount() const { return atlas.pageCount(); }
+    void splitImage(const string &baseImageRef, int numberOfParts, const string &baseTag);
+    // Só lê o tamanho: o handle já serve pra criar objetos e o arquivo é
+    // decodificado no primeiro frame que desenhar a imagem (ou antes, via prefetch).
+    // splitImage numa imagem registrada também fica preguiçoso.
+    TextureId registerImage(const string &path, const string &tag, float maxScale = 1.0f);
+    // Decodifica numa thread de fundo o que vai entrar em cena logo
+    // (ex.: inimigos da próxima onda durante o banner); o upload é no present
+    void prefetchImage(TextureId image);
+    void prefetchImage(const string &tag) { prefetchImage(findImage(tag)); }
+    bool isImageResident(TextureId id) const;
+    inline int pendingImages() const { return lazyImages; }
+
+    // Referências de objetos (createObject/addImage/destrutor já chamam)
+    void retainImage(TextureId id);
+    void releaseImage(TextureId id);
+    // Limite em bytes pra pixels de imagens (atlas incluso); 0 desliga o despejo
+    void setImageBudget(size_t bytes) { imageBudget = bytes; }
+    size_t getImageBudget() const { return imageBudget; }
+    MemoryReport memoryReport() const;
+
+    // nome -> handle (inválido se não existir); resolva uma vez e guarde o handle
+    TextureId findImage(const string &tag) const;
+    SoundId   findSound(const string &tag) const;
+    MusicId   findMusic(const string &tag) const;
+    const string& getImageTag(TextureId id) const;
+    inline SDL_Point getImageSize(TextureId id) const {
+        if (!id.valid() || id.index >= (int32_t)textures.size()) return SDL_Point{ 0, 0 };
+        return textures[id.index].size;
+    }
 
+    // Os draw* só valem dentro dos callbacks de desenho (onBeforeDraw/onAfterDraw,
+    // emissores): gravam na lista do frame. Fora deles (onStep, entre frames) o
+    // desenho é descartado, com um aviso no log na primeira vez.
     // >>> Parâmetro opcional fx (retrocompatível)
-    void drawImage(string imageRef, int x, int y, int w, int h, float angle,
+    void drawImage(TextureId image, int x, int y, int w, int h, float angle,
+                   const FxParams* fx = nullptr);
+    void drawImage(const string &imageRef, int x, int y, int w, int h, float angle,
                    const FxParams* fx = nullptr);
 
     void drawObject(Object *go);
+    void objectDepthChanged(Object *obj, int oldDepth);   // chamado pelo Object::setDepth
 
-    void loadSound(string path, string tag);
-    void playSound(string soundRef);
+    SoundId loadSound(const string &path, const string &tag);
+    void playSound(SoundId sound);
+    void playSound(const string &soundRef);
 
     // --- Música (Mix_Music) ---
-    void loadMusic(const std::string& path, const std::string& tag);
+    MusicId loadMusic(const std::string& path, const std::string& tag);
+    void playMusic(MusicId music, int loops = -1);
     void playMusic(const std::string& tag, int loops = -1);
     void stopMusic();
     void pauseMusic();
@@ -145,9 +381,10 @@ public:
     void setMusicVolume(int volume);
     string getCurrentMusicTag() const { return currentMusicTag; }    
 
-    Object *createObject(int x, int y, int w, int h, string texture, int type = 0, int depth = 0);
-    Object *createObject(int x, int y, string imageRef, int type);
-    Object *createObject(int x, int y, string imageRef);
+    Object *createObject(int x, int y, int w, int h, TextureId image, int type = 0, int depth = 0);
+    Object *createObject(int x, int y, int w, int h, const string &imageRef, int type = 0, int depth = 0);
+    Object *createObject(int x, int y, const string &imageRef, int type);
+    Object *createObject(int x, int y, const string &imageRef);
     Object *createObject(int x, int y, int type);
     Object *createObject(int x, int y);
 
@@ -160,7 +397,21 @@ public:
 
     TTF_Font* getFont(const string &name, int size);
 
-    void drawText(const string &text, int x, int y, const string &fontName, int fontSize, SDL_Color color, bool centered);
+    GlyphAtlas* getGlyphAtlas(const string &name, int size);
+
+    // dynamic = texto que muda todo frame (contadores): desenha por glifos do atlas
+    // em vez de passar pelo cache de strings
+    void drawText(const string &text, int x, int y, const string &fontName, int fontSize, SDL_Color color, bool centered,
+                  bool dynamic = false);
+
+    // --- Cache de texto renderizado ---
+    inline void     setTextCacheSize(size_t n)   { textCache.setCapacity(n); }
+    inline uint64_t textCacheHits() const        { return textCache.getHits(); }
+    inline uint64_t textCacheMisses() const      { return textCache.getMisses(); }
+    inline uint64_t textCacheEvictions() const   { return textCache.getEvictions(); }
+    inline void     resetTextCacheStats()        { textCache.resetStats(); }
+
+    // primitivas: mesma regra do drawImage (só dentro dos callbacks de desenho)
     void drawRect(int x, int y, int w, int h, const Color& c, bool filled);
     void drawLine(int x1, int y1, int x2, int y2, const Color& c);
     void drawCircle(int cx, int cy, int radius, const Color& c, bool filled);
@@ -170,6 +421,56 @@ public:
     void drawPolygon(const vector<pair<int,int>>& pts, const Color& c, bool closed=true);
     void drawCross(int cx, int cy, int size, const Color& c);
 
+    const RenderStats& getRenderStats() const { return lastStats; }
+
+    // Ritmo dos frames: Fixed (padrão, 60 fps), VSync (cai pra Fixed se o
+    // renderer não suportar) ou Uncapped
+    void setFramePacing(PaceMode mode);
+    inline PaceMode getFramePacing() const       { return pacer.getMode(); }
+    inline void setFrameRate(double fps)         { pacer.setTargetFps(fps); }
+    inline const FrameTiming& getFrameTiming() const { return pacer.getTiming(); }
+
+    // --- Partículas ---
+    inline EmitterId createEmitter(int depth, const FxParams &fx = FxParams{}) { return particles.create(depth, fx); }
+    inline ParticleEmitter* getEmitter(EmitterId id)        { return particles.get(id); }
+    inline void emitParticle(EmitterId id, const Particle &p) {
+        if (ParticleEmitter *e = particles.get(id)) e->emit(p);
+    }
+    inline size_t particleCount() const                     { return particles.count(); }
+
+    // --- Fundo de estrelas (paralaxe) ---
+    inline Starfield& getStarfield() { return starfield; }
+
+    // Bloom de tela cheia: objetos com glow viram emissivos (cor/alpha do glow;
+    // o raio não é usado) e o halo sai de um único blur por frame. Só no GPU.
+    void setBloom(bool on);
+    inline bool isBloomEnabled() const           { return bloomOn; }
+    inline void setBloomIntensity(float v)       { bloom.setIntensity(v); }   // 0..1 por nível
+
+    // Backend de desenho; só tem efeito antes do init
+    inline void setRenderBackend(RenderBackend b) { if (!window) backend = b; }
+    inline RenderBackend getRenderBackend() const { return backend; }
+    inline void setSoftwareFilter(SoftFilter f)   { softRenderer.setFilter(f); }
+    inline const char* softwareKernels() const    { return softRenderer.getKernelName(); }
+    inline void setSoftwareTileSize(int size)     { softRenderer.setTileSize(size); }
+    inline void setSoftwareThreads(int n)         { softRenderer.setThreads(n); }   // 0 = um por núcleo
+    inline const vector<SoftTile>& softwareTiles() const { return softRenderer.getTiles(); }
+    inline void setCulling(bool on) { culling = on; }
+
+    // Simulação numa thread própria: calculateAndRender passa a apresentar o frame
+    // anterior enquanto calcula o próximo, e só retorna com a simulação parada
+    // (o código do laço do jogo pode mexer nos objetos normalmente).
+    void setThreaded(bool on);
+    bool isThreaded() const { return threaded; }
+
+    // Taxa da simulação (passos por segundo), independente da taxa de desenho.
+    // 0 volta ao antigo: um calculate por frame.
+    void setSimulationRate(double hz);
+    inline double getSimulationRate() const { return simStepMs > 0.0 ? 1000.0 / simStepMs : 0.0; }
+    inline void   setMaxStepsPerFrame(int n) { maxStepsPerFrame = n > 0 ? n : 1; }
+    inline int    getLastSteps() const       { return pendingSteps; }
+    inline float  getInterpolation() const   { return renderAlpha; }
+
     void calculateAndRender();
     void calculateAll();
     void renderAll();
@@ -190,4 +491,6 @@ public:
     }
 
     Object* getObject(int i);
+    // vivos / parados no pool / pico; sem alocação com o jogo em regime
+    const ObjectPoolStats& getObjectPoolStats() const { return objectPool.getStats(); }
 };
@@ -0,0 +1,81 @@
+#include "framepacer.h"
+#include <algorithm>
+#include <cmath>
+
+static const size_t FRAME_HISTORY = 120;
+
+FramePacer::FramePacer()
+{
+    freq = SDL_GetPerformanceFrequency();
+    setTargetFps(targetFps);
+}
+
+void FramePacer::setTargetFps(double fps)
+{
+    targetFps = fps > 1.0 ? fps : 1.0;
+    period = (Uint64)(double(freq) / targetFps);
+    reset();
+}
+
+void FramePacer::reset()
+{
+    deadline  = 0;
+    lastStamp = 0;
+    history.clear();
+    historyPos = 0;
+    timing = FrameTiming{};
+}
+
+void FramePacer::wait()
+{
+    Uint64 now = SDL_GetPerformanceCounter();
+
+    if (mode == PaceMode::Fixed) {
+        if (deadline == 0) deadline = now + period;
+
+        if (now < deadline) {
+            const double remainingMs = double(deadline - now) * 1000.0 / double(freq);
+            if (remainingMs > spinMs) SDL_Delay((Uint32)(remainingMs - spinMs));
+            do {
+                now = SDL_GetPerformanceCounter();
+            } while (now < deadline);
+            deadline += period;
+        } else {
+            // estourou: começa a contar de agora em vez de tentar recuperar
+            // os frames perdidos (o que daria uma rajada de frames sem espera)
+            timing.missed++;
+            deadline = now + period;
+        }
+    }
+
+    record(now);
+}
+
+void FramePacer::record(Uint64 now)
+{
+    if (lastStamp != 0) {
+        const double ms = double(now - lastStamp) * 1000.0 / double(freq);
+        if (history.size() < FRAME_HISTORY) history.push_back(ms);
+        else history[historyPos] = ms;
+        historyPos = (historyPos + 1) % FRAME_HISTORY;
+
+        double sum = 0.0, lo = history[0], hi = history[0];
+        for (double v : history) {
+            sum += v;
+            lo = min(lo, v);
+            hi = max(hi, v);
+        }
+        const double avg = sum / double(history.size());
+        double var = 0.0;
+        for (double v : history) var += (v - avg) * (v - avg);
+
+        timing.lastMs   = ms;
+        timing.avgMs    = avg;
+        timing.minMs    = lo;
+        timing.maxMs    = hi;
+        timing.jitterMs = std::sqrt(var / double(history.size()));
+        timing.fps      = avg > 0.0 ? 1000.0 / avg : 0.0;
+        timing.frames++;
+    }
+    lastStamp = now;
+}
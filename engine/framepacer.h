@@ -0,0 +1,60 @@
+#pragma once
+#include <SDL2/SDL.h>
+#include <vector>
+#include <cstdint>
+
+using namespace std;
+
+enum class PaceMode {
+    Fixed,      // dorme até completar 1/fps (com spin no finalzinho)
+    VSync,      // o SDL_RenderPresent espera o retrace; o pacer só mede
+    Uncapped    // sem espera
+};
+
+// Tempos dos últimos frames (janela deslizante), em ms
+struct FrameTiming {
+    double lastMs   = 0.0;
+    double avgMs    = 0.0;
+    double minMs    = 0.0;
+    double maxMs    = 0.0;
+    double jitterMs = 0.0;     // desvio padrão do tempo de frame
+    double fps      = 0.0;     // 1000 / avgMs
+    uint64_t frames = 0;       // total desde o reset
+    uint64_t missed = 0;       // frames que estouraram o prazo (modo Fixed)
+};
+
+// Ritmo de frames pelo contador de alta resolução: wait() é chamado logo
+// depois do present e dorme só o que sobra do orçamento do frame. O
+// SDL_Delay acorda com atraso de até alguns ms, então a última parte
+// (spinMs) é feita em espera ativa.
+class FramePacer {
+public:
+    FramePacer();
+
+    void setMode(PaceMode m)       { mode = m; reset(); }
+    PaceMode getMode() const       { return mode; }
+    void setTargetFps(double fps);
+    double getTargetFps() const    { return targetFps; }
+    void setSpinMs(double ms)      { spinMs = ms < 0.0 ? 0.0 : ms; }
+
+    void reset();
+    void wait();
+
+    const FrameTiming& getTiming() const { return timing; }
+
+private:
+    PaceMode mode = PaceMode::Fixed;
+    double targetFps = 60.0;
+    double spinMs    = 1.0;
+
+    Uint64 freq     = 0;
+    Uint64 period   = 0;     // orçamento do frame em ticks
+    Uint64 deadline = 0;     // fim do frame atual (0 = ainda não começou)
+    Uint64 lastStamp = 0;
+
+    vector<double> history;  // tempos de frame (anel)
+    size_t historyPos = 0;
+    FrameTiming timing;
+
+    void record(Uint64 now);
+};
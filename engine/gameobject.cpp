@@ -24,6 +24,7 @@ void Object::calculate()
     }
     x_prev = x;
     y_prev = y;
+    prev_valid = true;
 
     //-----------------------------------------------------
     force_y += gravity;
@@ -109,22 +110,109 @@ bool Object::destroyIfLowEnergy()
     return false;
 }
 
+void Object::reset(int x, int y, int w, int h, int type, int depth)
+{
+    this->x = x;
+    this->y = y;
+    this->w = w;
+    this->h = h;
+    this->type  = type;
+    this->depth = depth;
+    tag    = 0;
+    parent = nullptr;
+    visible = true;
+
+    x_start = x;
+    y_start = y;
+    x_prev  = x;
+    y_prev  = y;
+    prev_valid = false;
+
+    x_scale = 1.0f;
+    y_scale = 1.0f;
+
+    force_x = 0;
+    force_y = 0;
+    force_friction = 0;
+    gravity = 0;
+
+    impulse_x = 0;
+    impulse_y = 0;
+    impulse_friction = 0;
+
+    energy = 10;
+    attack = 10;
+    shield = 0;
+    collision_group = 0;
+
+    wraph = false;
+    wrapv = false;
+
+    angle = 0;
+    angle_speed = 0;
+
+    image_index = 0;
+    image_speed = 0;
+    image_cycle = LOOP;
+    centered    = true;
+
+    font_name.clear();
+    font_color = {255, 255, 255, 255};
+    font_size = 0;
+    text.clear();
+    text_dynamic = false;
+    cullable = true;
+    is_static = false;
+    defunct = false;
+    engine = nullptr;
+    slot = -1;
+    bucket_slot = -1;
+    queued = false;
+    seq = 0;
+
+    alarms.clear();
+    images.clear();
+    fx = FxParams{};
+
+    onAnimationEnd    = nullptr;
+    onBeforeDraw      = nullptr;
+    onAfterDraw       = nullptr;
+    onBeforeCalculate = nullptr;
+    onAfterCalculate  = nullptr;
+    onAlarmFinished   = nullptr;
+    onCollision       = nullptr;
+}
+
 Object::~Object()
 {
+    if (engine)
+        for (TextureId id : images) engine->releaseImage(id);
 }
 
-void Object::addImageRef(string image)
+void Object::addImage(TextureId image)
 {
     images.push_back(image);
+    if (engine) engine->retainImage(image);   // antes do createObject, quem conta é ele
+}
+
+void Object::addImageRef(const string &image)
+{
+    addImage(engine ? engine->findImage(image) : TextureId{});
 }
 
-string Object::getCurrentImageRef()
+TextureId Object::getCurrentImage() const
 {
     if (images.size() == 0)
-        return "";
+        return TextureId{};
     return images[(int)image_index];
 }
 
+string Object::getCurrentImageRef() const
+{
+    TextureId id = getCurrentImage();
+    return (engine && id.valid()) ? engine->getImageTag(id) : "";
+}
+
 void Object::setAlarm(int frames, int id)
 {
     alarms.push_back({frames, frames, id});
@@ -326,7 +414,13 @@ bool Object::getWrapH() const { return wraph; }
 bool Object::getWrapV() const { return wrapv; }
 
 int Object::getDepth() const { return depth; }
-void Object::setDepth(int depth) { this->depth = depth; }
+void Object::setDepth(int depth)
+{
+    if (this->depth == depth) return;
+    const int old = this->depth;
+    this->depth = depth;
+    if (engine) engine->objectDepthChanged(this, old);
+}
 
 int Object::getCollisionGroup() const { return collision_group; }
 void Object::setCollisionGroup(int collisionGroup) { this->collision_group = collision_group; }
@@ -360,6 +454,13 @@ int Object::getFontSize() const { return font_size; }
 string Object::getText() const { return text; }
 void Object::setText(string text) { this->text = text; }
 
+bool Object::isTextDynamic() const { return text_dynamic; }
+void Object::setTextDynamic(bool dynamic) { this->text_dynamic = dynamic; }
+bool Object::isCullable() const { return cullable; }
+void Object::setCullable(bool cullable) { this->cullable = cullable; }
+bool Object::isStatic() const { return is_static; }
+void Object::setStatic(bool isStatic) { this->is_static = isStatic; }
+
 
 Engine* Object::getEngine() const { return engine; }
 void Object::setEngine(Engine *engine) { this->engine = engine;}
@@ -4,6 +4,7 @@
 #include <vector>
 #include <functional>
 #include <cstdint>
+#include "handles.h"
 
 using namespace std;
 
@@ -58,6 +59,7 @@ private:
     float y_start;          // valor inicial de y
     float x_prev;           // x anterior
     float y_prev;           // y anterior
+    bool  prev_valid;       // já passou por um calculate (x_prev/y_prev valem)
     float x_scale;          // escala do objeto horizontal
     float y_scale;          // escala do objeto vertical;
 
@@ -106,9 +108,19 @@ private:
     Color  font_color;       // cor da fonte
     int    font_size;        // tamanho da fonte
     string text;             // se definido será mostrado na fonte acima
+    bool   text_dynamic;     // texto muda todo frame (desenha por glifos, sem cache de string)
+    bool   cullable;         // pode ser pulado no desenho quando a imagem está fora da tela
+    bool   is_static;        // vai pra camada em cache do seu depth (só redesenha se mudar)
 
     vector<Alarm> alarms;    // alarmes, ao finalizar, gera um evento
 
+    // posição nas listas da Engine (remoção em O(1)); -1 = fora delas
+    friend class Engine;
+    int  slot;               // índice em Engine::ordered_objects
+    int  bucket_slot;        // índice no balde do depth
+    bool queued;             // já está na fila de destruição
+    uint64_t seq;            // ordem de criação: desempata o desenho dentro do depth
+
 public:
     static constexpr Color COLOR_WHITE       = {255, 255, 255, 255};
     static constexpr Color COLOR_BLACK       = {0, 0, 0, 255};
@@ -121,7 +133,7 @@ public:
     static constexpr Color COLOR_GRAY        = {128, 128, 128, 255};
     static constexpr Color COLOR_TRANSPARENT = {0, 0, 0, 0};
 
-    vector<string> images;   // referencias de imagens assossiadas a esse objeto
+    vector<TextureId> images; // imagens associadas a esse objeto (handles da Engine)
 
     // ---------- FX por-objeto (defaults neutros) ----------
     FxParams fx;
@@ -137,56 +149,31 @@ public:
 
     ~Object();
 
-    Object(int x, int y, int w, int h, int type = 0, int depth = 0) : x(x), y(y), w(w), h(h), type(type), depth(depth)
-    {
-        visible = true;
-
-        x_start = x;
-        y_start = y;
-        x_prev  = x;
-        y_prev  = y;
-
-        x_scale = 1.0f;
-        y_scale = 1.0f;
-
-        force_x = 0;
-        force_y = 0;
-        force_friction = 0;
-        gravity = 0;
-
-        impulse_x = 0;
-        impulse_y = 0;
-        impulse_friction = 0;
-
-        energy = 10;
-        attack = 10;
-        shield = 0;
-        collision_group = 0;
+    // A engine guarda objetos pelo endereço e cada um segura referências das
+    // suas imagens: uma cópia soltaria as mesmas referências duas vezes
+    Object(const Object&) = delete;
+    Object& operator=(const Object&) = delete;
 
-        wraph = false;
-        wrapv = false;
-
-        angle = 0;
-        angle_speed = 0;
-
-        image_index = 0;
-        image_speed = 0;
-        image_cycle = LOOP;
-        centered    = true;
-
-        font_color = {255, 255, 255, 255};
-        defunct = false;
+    Object(int x, int y, int w, int h, int type = 0, int depth = 0)
+    {
+        reset(x, y, w, h, type, depth);
     }
 
-    Object(int x, int y, int w, int h, string image, int type = 0, int depth = 0) : Object(x, y, w, h, type, depth)
+    Object(int x, int y, int w, int h, TextureId image, int type = 0, int depth = 0) : Object(x, y, w, h, type, depth)
     {
-        addImageRef(image);
+        addImage(image);
     }
 
+    // Volta aos valores de um objeto novo (o pool recicla objetos por aqui).
+    // Vetores e strings são esvaziados sem perder a capacidade; callbacks e
+    // engine são soltos (as referências de imagem ficam com quem chama)
+    void reset(int x, int y, int w, int h, int type = 0, int depth = 0);
+
     void setScale(float sx, float sy);
     void setScale(float s);
 
-    void addImageRef(string image);
+    void addImage(TextureId image);
+    void addImageRef(const string &image);  // resolve o nome na Engine uma vez
     void calculate();
     void setFont(string name, int size, Color color);
     void setWrap(bool h, bool v);
@@ -204,7 +191,8 @@ public:
     void applyImpact(Object *other);
     bool destroyIfLowEnergy();
     float getFinalDirection() const;
-    string getCurrentImageRef();
+    TextureId getCurrentImage() const;
+    string getCurrentImageRef() const;      // nome da imagem atual (debug/compat)
 
     void setAlarm(int frames, int id);
     void finishAlarm(int id);
@@ -231,6 +219,7 @@ public:
 
     float getXPrev() const;
     float getYPrev() const;
+    bool  hasPrevPosition() const { return prev_valid; }
     float getXStart() const;
     float getYStart() const;
 
@@ -278,6 +267,8 @@ public:
     bool getWrapV() const;
 
     int  getDepth() const;
+    // Muda de balde sem perder a ordem de criação: no depth novo o objeto fica
+    // atrás dos criados depois dele, como se tivesse nascido ali
     void setDepth(int depth);
 
 
@@ -313,6 +304,13 @@ public:
     string getText() const;
     void setText(string text);
 
+    bool isTextDynamic() const;
+    void setTextDynamic(bool dynamic);
+    bool isCullable() const;
+    void setCullable(bool cullable);   // false se os callbacks de desenho pintam fora da imagem
+    bool isStatic() const;
+    void setStatic(bool isStatic);     // callbacks de desenho só rodam quando a camada é remontada
+
     Engine* getEngine() const;
     void setEngine(Engine *engine);
 
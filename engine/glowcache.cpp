@@ -0,0 +1,120 @@
+#include "glowcache.h"
+#include "spritebatch.h"
+#include <cmath>
+
+const GlowHalo* GlowCache::get(const GlowKey &key)
+{
+    if (!supported || !renderer || !state || key.radius <= 0 || key.w <= 0 || key.h <= 0) return nullptr;
+
+    auto it = index.find(key);
+    if (it != index.end()) {
+        ++hits;
+        if (it->second != lru.begin()) lru.splice(lru.begin(), lru, it->second);
+        return &it->second->second;
+    }
+
+    ++misses;
+    GlowHalo halo;
+    if (!bake(key, halo)) return nullptr;
+
+    lru.emplace_front(key, halo);
+    index[key] = lru.begin();
+
+    while (index.size() > capacity) {
+        auto &last = lru.back();
+        destroy(last.second.texture);
+        index.erase(last.first);
+        lru.pop_back();
+    }
+    return &lru.front().second;
+}
+
+void GlowCache::destroy(SDL_Texture *t)
+{
+    if (!t) return;
+    if (state) state->forget(t);
+    SDL_DestroyTexture(t);
+}
+
+void GlowCache::clear()
+{
+    for (auto &item : lru)
+        destroy(item.second.texture);
+    lru.clear();
+    index.clear();
+}
+
+void GlowCache::forget(SDL_Texture *source)
+{
+    for (auto it = lru.begin(); it != lru.end();) {
+        if (it->first.texture == source) {
+            destroy(it->second.texture);
+            index.erase(it->first);
+            it = lru.erase(it);
+        } else {
+            ++it;
+        }
+    }
+}
+
+bool GlowCache::bake(const GlowKey &key, GlowHalo &out)
+{
+    const int R  = key.radius;
+    const int hw = key.w + 2 * R;
+    const int hh = key.h + 2 * R;
+
+    // Soma as cópias no RGB ponderando pelo alpha de cada uma; o alpha do halo fica 255.
+    // Desenhado depois com ADD e alpha glow_a, dá o mesmo resultado dos anéis por frame.
+    const SDL_BlendMode bakeBlend = SDL_ComposeCustomBlendMode(
+        SDL_BLENDFACTOR_SRC_ALPHA, SDL_BLENDFACTOR_ONE, SDL_BLENDOPERATION_ADD,
+        SDL_BLENDFACTOR_ZERO,      SDL_BLENDFACTOR_ONE, SDL_BLENDOPERATION_ADD);
+    if (!state->textureBlend(key.texture, bakeBlend)) {
+        supported = false;
+        return false;
+    }
+
+    SDL_Texture *halo = SDL_CreateTexture(renderer, SDL_PIXELFORMAT_ARGB8888, SDL_TEXTUREACCESS_TARGET, hw, hh);
+    if (!halo) {
+        supported = false;
+        return false;
+    }
+
+    SDL_Texture *prevTarget = SDL_GetRenderTarget(renderer);
+    if (SDL_SetRenderTarget(renderer, halo) != 0) {
+        SDL_DestroyTexture(halo);
+        supported = false;
+        return false;
+    }
+
+    state->drawColor(0, 0, 0, 255);
+    SDL_RenderClear(renderer);
+
+    const Uint8 gr = Uint8(key.rgb >> 16), gg = Uint8(key.rgb >> 8), gb = Uint8(key.rgb);
+
+    SpriteBatch batch;
+    batch.setRenderer(renderer, state);
+    SpriteCmd cmd;
+    cmd.texture = key.texture;
+    cmd.src     = key.src;
+    cmd.blend   = bakeBlend;
+    for (int r = 1; r <= R; ++r) {
+        const int offsets[8][2] = {
+            {-r,0},{r,0},{0,-r},{0,r},{-r,-r},{-r,r},{r,-r},{r,r}
+        };
+        const float falloff = 1.0f - (float)r / (R + 1);
+        cmd.color = SDL_Color{ gr, gg, gb, (Uint8)std::round(255.0f * falloff) };
+        for (auto &v : offsets) {
+            cmd.dst = SDL_FRect{ float(R + v[0]), float(R + v[1]), float(key.w), float(key.h) };
+            batch.add(cmd);
+        }
+    }
+    batch.flush();
+
+    SDL_SetRenderTarget(renderer, prevTarget);
+    state->textureBlend(halo, SDL_BLENDMODE_ADD);
+
+    out.texture = halo;
+    out.w = hw;
+    out.h = hh;
+    return true;
+}
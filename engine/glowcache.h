@@ -0,0 +1,83 @@
+#pragma once
+#include <SDL2/SDL.h>
+#include <list>
+#include <unordered_map>
+#include <cstdint>
+#include "renderstate.h"
+
+using namespace std;
+
+// Identifica um halo: imagem de origem + tamanho na tela + raio + cor do glow
+struct GlowKey {
+    SDL_Texture *texture;
+    SDL_Rect     src;
+    int          w, h;
+    int          radius;
+    Uint32       rgb;
+    bool operator==(const GlowKey &o) const {
+        return texture == o.texture && src.x == o.src.x && src.y == o.src.y &&
+               src.w == o.src.w && src.h == o.src.h && w == o.w && h == o.h &&
+               radius == o.radius && rgb == o.rgb;
+    }
+};
+struct GlowKeyHash {
+    size_t operator()(const GlowKey &k) const {
+        size_t h = hash<const void*>()(k.texture);
+        auto mix = [&h](uint64_t v) { h ^= hash<uint64_t>()(v) + 0x9e3779b9 + (h << 6) + (h >> 2); };
+        mix((uint64_t(uint32_t(k.src.x)) << 32) | uint32_t(k.src.y));
+        mix((uint64_t(uint32_t(k.src.w)) << 32) | uint32_t(k.src.h));
+        mix((uint64_t(uint32_t(k.w)) << 32) | uint32_t(k.h));
+        mix((uint64_t(uint32_t(k.radius)) << 32) | k.rgb);
+        return h;
+    }
+};
+
+// Halo de glow pré-renderizado. Tem (w + 2*radius) x (h + 2*radius) e é desenhado
+// deslocado de -radius, com blend aditivo e alpha = fx.glow_a.
+struct GlowHalo {
+    SDL_Texture *texture = nullptr;
+    int w = 0, h = 0;
+};
+
+// Cache LRU de halos. Cada halo é assado uma vez num render target com os mesmos
+// anéis que o drawImage fazia por frame (8 cópias por anel, falloff linear).
+class GlowCache {
+public:
+    explicit GlowCache(size_t capacity = 64) : capacity(capacity) {}
+    ~GlowCache() { clear(); }
+
+    GlowCache(const GlowCache&) = delete;
+    GlowCache& operator=(const GlowCache&) = delete;
+
+    void setRenderer(SDL_Renderer *r, RenderState *s) { renderer = r; state = s; }
+
+    // nullptr se o renderer não suporta render target / blend customizado
+    // (nesse caso o chamador desenha os anéis como antes)
+    const GlowHalo* get(const GlowKey &key);
+
+    void clear();
+    // a imagem de origem vai ser destruída: o ponteiro pode voltar em outra textura
+    void forget(SDL_Texture *source);
+    bool isSupported() const { return supported; }
+
+    size_t size() const { return index.size(); }
+    uint64_t getHits() const   { return hits; }
+    uint64_t getMisses() const { return misses; }
+
+private:
+    using Item = pair<GlowKey, GlowHalo>;
+
+    SDL_Renderer *renderer = nullptr;
+    RenderState  *state    = nullptr;
+
+    size_t capacity;
+    list<Item> lru;
+    unordered_map<GlowKey, list<Item>::iterator, GlowKeyHash> index;
+    bool supported = true;
+
+    uint64_t hits = 0;
+    uint64_t misses = 0;
+
+    bool bake(const GlowKey &key, GlowHalo &out);
+    void destroy(SDL_Texture *t);
+};
@@ -0,0 +1,162 @@
+#include "glyphatlas.h"
+
+static constexpr int GLYPH_PAD = 1;  // espaço entre glifos (evita sangrar no filtro)
+
+uint32_t utf8Next(const string &s, size_t &i)
+{
+    const unsigned char c = (unsigned char)s[i++];
+    if (c < 0x80) return c;
+
+    int extra = 0;
+    uint32_t cp = 0;
+    if      ((c & 0xE0) == 0xC0) { extra = 1; cp = c & 0x1F; }
+    else if ((c & 0xF0) == 0xE0) { extra = 2; cp = c & 0x0F; }
+    else if ((c & 0xF8) == 0xF0) { extra = 3; cp = c & 0x07; }
+    else return '?';
+
+    for (int k = 0; k < extra; ++k) {
+        if (i >= s.size() || ((unsigned char)s[i] & 0xC0) != 0x80) return '?';
+        cp = (cp << 6) | ((unsigned char)s[i++] & 0x3F);
+    }
+    return cp;
+}
+
+bool GlyphAtlas::build(SDL_Renderer *renderer, TTF_Font *f)
+{
+    release();
+    if (!renderer || !f) return false;
+    font = f;
+
+    // 1) rasteriza cada glifo (branco; a cor vem do vértice)
+    const SDL_Color white{ 255, 255, 255, 255 };
+    array<SDL_Surface*, LAST_GLYPH + 1> surfs{};
+    lineH = TTF_FontHeight(font);
+
+    for (int cp = FIRST_GLYPH; cp <= LAST_GLYPH; ++cp) {
+        if (cp >= 127 && cp < 160) continue; // controles
+        if (!TTF_GlyphIsProvided(font, (Uint16)cp)) continue;
+
+        int minx, maxx, miny, maxy, adv;
+        if (TTF_GlyphMetrics(font, (Uint16)cp, &minx, &maxx, &miny, &maxy, &adv) != 0) continue;
+
+        SDL_Surface *s = TTF_RenderGlyph_Blended(font, (Uint16)cp, white);
+        if (!s) continue;
+        SDL_SetSurfaceBlendMode(s, SDL_BLENDMODE_NONE);  // copia alpha como está
+        surfs[cp] = s;
+        glyphs[cp].advance = adv;
+        glyphs[cp].src.w   = s->w;
+        glyphs[cp].src.h   = s->h;
+    }
+
+    // 2) empacota em linhas (todas as células têm ~a mesma altura)
+    const int atlasW = lineH <= 24 ? 512 : 1024;
+    int penX = GLYPH_PAD, penY = GLYPH_PAD, rowH = 0;
+    for (int cp = FIRST_GLYPH; cp <= LAST_GLYPH; ++cp) {
+        if (!surfs[cp]) continue;
+        Glyph &g = glyphs[cp];
+        if (penX + g.src.w + GLYPH_PAD > atlasW) {
+            penX = GLYPH_PAD;
+            penY += rowH + GLYPH_PAD;
+            rowH = 0;
+        }
+        g.src.x = penX;
+        g.src.y = penY;
+        penX += g.src.w + GLYPH_PAD;
+        if (g.src.h > rowH) rowH = g.src.h;
+    }
+    const int atlasH = penY + rowH + GLYPH_PAD;
+
+    // 3) copia tudo numa superfície e sobe uma textura só
+    SDL_Surface *atlas = SDL_CreateRGBSurfaceWithFormat(0, atlasW, atlasH, 32, SDL_PIXELFORMAT_ARGB8888);
+    if (atlas) {
+        SDL_FillRect(atlas, nullptr, 0);
+        for (int cp = FIRST_GLYPH; cp <= LAST_GLYPH; ++cp) {
+            if (!surfs[cp]) continue;
+            SDL_Rect dst = glyphs[cp].src;
+            SDL_BlitSurface(surfs[cp], nullptr, atlas, &dst);
+            glyphs[cp].present = true;
+        }
+        texture = SDL_CreateTextureFromSurface(renderer, atlas);
+        texW = atlasW;
+        texH = atlasH;
+        SDL_FreeSurface(atlas);
+    }
+
+    for (SDL_Surface *s : surfs)
+        if (s) SDL_FreeSurface(s);
+
+    if (!texture) {
+        release();
+        return false;
+    }
+    SDL_SetTextureBlendMode(texture, SDL_BLENDMODE_BLEND);
+    return true;
+}
+
+void GlyphAtlas::release()
+{
+    if (texture) SDL_DestroyTexture(texture);
+    texture = nullptr;
+    font = nullptr;
+    texW = texH = lineH = 0;
+    glyphs.fill(Glyph{});
+}
+
+bool GlyphAtlas::covers(const string &text) const
+{
+    if (!texture) return false;
+    for (size_t i = 0; i < text.size();) {
+        if (!glyphFor(utf8Next(text, i))) return false;
+    }
+    return true;
+}
+
+void GlyphAtlas::measure(const string &text, int &outW, int &outH) const
+{
+    int w = 0;
+    uint32_t prev = 0;
+    for (size_t i = 0; i < text.size();) {
+        const uint32_t cp = utf8Next(text, i);
+        const Glyph *g = glyphFor(cp);
+        if (!g) continue;
+        if (prev) w += TTF_GetFontKerningSizeGlyphs(font, (Uint16)prev, (Uint16)cp);
+        w += g->advance;
+        prev = cp;
+    }
+    outW = w;
+    outH = lineH;
+}
+
+void GlyphAtlas::appendQuads(const string &text, float x, float y, SDL_Color color,
+                             vector<SDL_Vertex> &verts, vector<int> &indices) const
+{
+    if (!texture) return;
+    const float iw = 1.0f / texW;
+    const float ih = 1.0f / texH;
+
+    float penX = x;
+    uint32_t prev = 0;
+    for (size_t i = 0; i < text.size();) {
+        const uint32_t cp = utf8Next(text, i);
+        const Glyph *g = glyphFor(cp);
+        if (!g) continue;
+        if (prev) penX += TTF_GetFontKerningSizeGlyphs(font, (Uint16)prev, (Uint16)cp);
+        prev = cp;
+
+        const SDL_Rect &r = g->src;
+        if (cp != ' ' && r.w > 0 && r.h > 0) {
+            const float x0 = penX,      y0 = y;
+            const float x1 = penX + r.w, y1 = y + r.h;
+            const float u0 = r.x * iw,          v0 = r.y * ih;
+            const float u1 = (r.x + r.w) * iw,  v1 = (r.y + r.h) * ih;
+
+            const int base = (int)verts.size();
+            verts.push_back({ { x0, y0 }, color, { u0, v0 } });
+            verts.push_back({ { x1, y0 }, color, { u1, v0 } });
+            verts.push_back({ { x1, y1 }, color, { u1, v1 } });
+            verts.push_back({ { x0, y1 }, color, { u0, v1 } });
+            indices.insert(indices.end(), { base, base + 1, base + 2, base, base + 2, base + 3 });
+        }
+        penX += g->advance;
+    }
+}
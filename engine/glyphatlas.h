@@ -0,0 +1,61 @@
+#pragma once
+#include <SDL2/SDL.h>
+#include <SDL2/SDL_ttf.h>
+#include <string>
+#include <vector>
+#include <array>
+#include <cstdint>
+
+using namespace std;
+
+// Atlas de glifos de uma fonte (FontKey).
+// Os glifos são rasterizados uma vez em branco; o texto vira quads coloridos
+// por vértice desenhados num único SDL_RenderGeometry.
+class GlyphAtlas {
+public:
+    static constexpr int FIRST_GLYPH = 32;   // ' '
+    static constexpr int LAST_GLYPH  = 255;  // fim do Latin-1 (acentos do português)
+
+    GlyphAtlas() = default;
+    ~GlyphAtlas() { release(); }
+
+    GlyphAtlas(const GlyphAtlas&) = delete;
+    GlyphAtlas& operator=(const GlyphAtlas&) = delete;
+
+    // Rasteriza os glifos e sobe a textura. false se a fonte não puder ser usada.
+    bool build(SDL_Renderer *renderer, TTF_Font *font);
+    void release();
+
+    bool isReady() const { return texture != nullptr; }
+    SDL_Texture *getTexture() const { return texture; }
+
+    // true se todos os caracteres da string existem no atlas
+    bool covers(const string &text) const;
+
+    // Largura/altura que a string ocupa (mesma altura de TTF_RenderUTF8_Blended)
+    void measure(const string &text, int &outW, int &outH) const;
+
+    // Acrescenta os quads da string (canto superior esquerdo em x,y)
+    void appendQuads(const string &text, float x, float y, SDL_Color color,
+                     vector<SDL_Vertex> &verts, vector<int> &indices) const;
+
+private:
+    struct Glyph {
+        SDL_Rect src{0, 0, 0, 0};  // região no atlas
+        int  advance = 0;
+        bool present = false;
+    };
+
+    TTF_Font    *font    = nullptr;  // pertence ao fontCache da Engine
+    SDL_Texture *texture = nullptr;
+    int texW = 0, texH = 0;
+    int lineH = 0;
+    array<Glyph, LAST_GLYPH + 1> glyphs{};
+
+    const Glyph* glyphFor(uint32_t cp) const {
+        return (cp >= FIRST_GLYPH && cp <= LAST_GLYPH && glyphs[cp].present) ? &glyphs[cp] : nullptr;
+    }
+};
+
+// Decodifica o próximo code point UTF-8 (avança i). Bytes inválidos viram '?'.
+uint32_t utf8Next(const string &s, size_t &i);
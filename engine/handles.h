@@ -0,0 +1,19 @@
+#pragma once
+#include <cstdint>
+#include <cstddef>
+
+// Handle compacto de um recurso carregado: índice no vetor denso do seu tipo.
+// O tipo (Tag) impede trocar textura por som sem querer. index < 0 = inválido.
+template <typename Tag>
+struct ResourceHandle {
+    int32_t index = -1;
+
+    bool valid() const { return index >= 0; }
+    bool operator==(const ResourceHandle &o) const { return index == o.index; }
+    bool operator!=(const ResourceHandle &o) const { return index != o.index; }
+};
+
+using TextureId = ResourceHandle<struct TextureTag>;
+using SoundId   = ResourceHandle<struct SoundTag>;
+using MusicId   = ResourceHandle<struct MusicTag>;
+using EmitterId = ResourceHandle<struct EmitterTag>;
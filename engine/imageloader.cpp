@@ -0,0 +1,110 @@
+#include "imageloader.h"
+#include "mipmap.h"
+#include <cstdio>
+#include <cstring>
+#include <iostream>
+
+void ImageLoader::request(int32_t index, const string &path, float maxScale)
+{
+    {
+        lock_guard<mutex> lock(m);
+        if (index == busyIndex) return;
+        for (const Job &j : queue)
+            if (j.index == index) return;
+        for (const LoadedImage &r : ready)
+            if (r.index == index) return;
+
+        queue.push_back(Job{ index, path, maxScale });
+        quit = false;
+        if (!worker.joinable()) worker = thread(&ImageLoader::run, this);
+    }
+    wake.notify_one();
+}
+
+bool ImageLoader::isQueued(int32_t index)
+{
+    lock_guard<mutex> lock(m);
+    if (index == busyIndex) return true;
+    for (const Job &j : queue)
+        if (j.index == index) return true;
+    for (const LoadedImage &r : ready)
+        if (r.index == index) return true;
+    return false;
+}
+
+void ImageLoader::collect(vector<LoadedImage> &out)
+{
+    lock_guard<mutex> lock(m);
+    if (ready.empty()) return;
+    out.insert(out.end(), ready.begin(), ready.end());
+    ready.clear();
+}
+
+void ImageLoader::stop()
+{
+    {
+        lock_guard<mutex> lock(m);
+        quit = true;
+        queue.clear();
+    }
+    wake.notify_all();
+    if (worker.joinable()) worker.join();
+
+    for (LoadedImage &r : ready)
+        for (SDL_Surface *s : r.levels) SDL_FreeSurface(s);
+    ready.clear();
+}
+
+void ImageLoader::run()
+{
+    unique_lock<mutex> lock(m);
+    for (;;) {
+        wake.wait(lock, [this] { return quit || !queue.empty(); });
+        if (quit) return;
+
+        Job job = move(queue.front());
+        queue.pop_front();
+        busyIndex = job.index;
+        lock.unlock();
+
+        vector<SDL_Surface*> levels = decode(job.path, job.maxScale);
+
+        lock.lock();
+        busyIndex = -1;
+        ready.push_back(LoadedImage{ job.index, move(levels) });
+    }
+}
+
+bool ImageLoader::probeSize(const string &path, int &w, int &h)
+{
+    // assinatura (8) + tamanho do chunk (4) + "IHDR" (4) + largura e altura big-endian
+    unsigned char header[24];
+    FILE *f = fopen(path.c_str(), "rb");
+    if (f) {
+        const size_t got = fread(header, 1, sizeof(header), f);
+        fclose(f);
+        static const unsigned char png[8] = { 0x89, 'P', 'N', 'G', '\r', '\n', 0x1A, '\n' };
+        if (got == sizeof(header) && memcmp(header, png, 8) == 0 && memcmp(header + 12, "IHDR", 4) == 0) {
+            w = int((Uint32(header[16]) << 24) | (Uint32(header[17]) << 16) | (Uint32(header[18]) << 8) | header[19]);
+            h = int((Uint32(header[20]) << 24) | (Uint32(header[21]) << 16) | (Uint32(header[22]) << 8) | header[23]);
+            return w > 0 && h > 0;
+        }
+    }
+
+    SDL_Surface *surface = IMG_Load(path.c_str());
+    if (!surface) return false;
+    w = surface->w;
+    h = surface->h;
+    SDL_FreeSurface(surface);
+    return true;
+}
+
+vector<SDL_Surface*> ImageLoader::decode(const string &path, float maxScale)
+{
+    SDL_Surface *surface = IMG_Load(path.c_str());
+    if (!surface) {
+        cerr << "Erro IMG_Load: " << path << " " << IMG_GetError() << endl;
+        return {};
+    }
+    return buildMipChain(surface, maxScale);
+}
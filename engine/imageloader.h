@@ -0,0 +1,64 @@
+#pragma once
+#include <SDL2/SDL.h>
+#include <SDL2/SDL_image.h>
+#include <vector>
+#include <deque>
+#include <string>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <cstdint>
+
+using namespace std;
+
+// Imagem decodificada fora da thread principal, esperando o upload
+struct LoadedImage {
+    int32_t index = -1;             // posição em Engine::textures
+    vector<SDL_Surface*> levels;    // cadeia de mips ARGB8888; vazia = falhou (o erro já foi logado)
+};
+
+// Decodifica PNGs numa thread de fundo. Só faz o que não toca no renderer
+// (IMG_Load e a cadeia de mips em ARGB8888); a textura é criada na thread
+// principal, quando as superfícies saem de collect().
+// A thread sobe no primeiro pedido e dorme quando a fila esvazia.
+class ImageLoader {
+public:
+    ImageLoader() = default;
+    ~ImageLoader() { stop(); }
+
+    ImageLoader(const ImageLoader&) = delete;
+    ImageLoader& operator=(const ImageLoader&) = delete;
+
+    // maxScale: ver buildMipChain
+    void request(int32_t index, const string &path, float maxScale);
+    bool isQueued(int32_t index);
+
+    // move pra `out` o que já foi decodificado (quem recebe libera as superfícies)
+    void collect(vector<LoadedImage> &out);
+
+    // descarta pedidos pendentes, termina a thread e libera o que não foi coletado
+    void stop();
+
+    // Tamanho da imagem sem decodificar: lê o IHDR do PNG; outros formatos
+    // caem num IMG_Load descartável
+    static bool probeSize(const string &path, int &w, int &h);
+    // IMG_Load + buildMipChain; serve em qualquer thread
+    static vector<SDL_Surface*> decode(const string &path, float maxScale);
+
+private:
+    struct Job {
+        int32_t index;
+        string  path;
+        float   maxScale;
+    };
+
+    thread worker;
+    mutex m;
+    condition_variable wake;
+    deque<Job> queue;
+    vector<LoadedImage> ready;
+    int32_t busyIndex = -1;        // pedido sendo decodificado agora
+    bool quit = false;
+
+    void run();
+};
@@ -5,20 +5,22 @@
 Input::Input() {}
 Input::~Input() { closeGamepads(); }
 
-void Input::beginFrame()
+void Input::beginFrame(bool keepEdges)
 {
     // 1) drena fila de eventos e captura quit
     quitFlag = false;
+    renderResetFlag = false;
     SDL_Event e;
     while (SDL_PollEvent(&e)) {
         if (e.type == SDL_QUIT) quitFlag = true;
+        if (e.type == SDL_RENDER_TARGETS_RESET || e.type == SDL_RENDER_DEVICE_RESET) renderResetFlag = true;
 
         // (opcional) trate aqui DEVICEADDED/REMOVED hot-plug dos pads:
         // if (e.type == SDL_CONTROLLERDEVICEADDED)  openGamepad(e.cdevice.which);
         // if (e.type == SDL_CONTROLLERDEVICEREMOVED){ /* fechar correspondente */ }
     }
 
-    kb_prev = kb_now;
+    if (!keepEdges) kb_prev = kb_now;
     int nkeys = 0;
     const Uint8* state = SDL_GetKeyboardState(&nkeys);
     kb_now.resize(nkeys);
@@ -27,7 +29,7 @@ void Input::beginFrame()
     // 3) Gamepads: snapshot de botões e eixos
     for (auto& p : pads) {
         if (!p.gc) continue;
-        p.prev = p.now; // copy anterior
+        if (!keepEdges) p.prev = p.now; // copy anterior
         for (int b = 0; b < SDL_CONTROLLER_BUTTON_MAX; ++b) {
             p.now[b] = SDL_GameControllerGetButton(p.gc, (SDL_GameControllerButton)b);
         }
@@ -11,11 +11,15 @@ public:
     Input();
     ~Input();
 
-    // Chamar 1x por frame, ANTES de ler estados
-    void beginFrame();
+    // Chamar 1x por frame, ANTES de ler estados.
+    // keepEdges: o frame anterior não rodou nenhum passo da simulação, então as
+    // transições dele ainda não foram vistas; compara com o estado de antes dele.
+    void beginFrame(bool keepEdges = false);
 
     // --- Quit / janela ---
     bool quitRequested() const { return quitFlag; }
+    // o driver perdeu o conteúdo das render targets (ou o device inteiro) neste frame
+    bool renderReset() const { return renderResetFlag; }
 
     // --- Teclado (usar SDL_Scancode, ex.: SDL_SCANCODE_SPACE) ---
     bool keyHeld(SDL_Scancode sc) const;
@@ -51,4 +55,5 @@ private:
 
     // --- Eventos / janela ---
     bool quitFlag = false;
+    bool renderResetFlag = false;
 };
@@ -0,0 +1,49 @@
+#include "layercache.h"
+
+StaticLayer* LayerCache::get(int depth)
+{
+    if (!supported || !renderer || !state) return nullptr;
+
+    StaticLayer &layer = layers[depth];
+    if (layer.texture) return &layer;
+
+    layer.texture = SDL_CreateTexture(renderer, SDL_PIXELFORMAT_ARGB8888, SDL_TEXTUREACCESS_TARGET, width, height);
+    if (!layer.texture || !state->textureBlend(layer.texture, composite)) {
+        if (layer.texture) SDL_DestroyTexture(layer.texture);
+        layers.erase(depth);
+        supported = false;
+        return nullptr;
+    }
+    return &layer;
+}
+
+bool LayerCache::begin(StaticLayer &layer)
+{
+    prevTarget = SDL_GetRenderTarget(renderer);
+    if (SDL_SetRenderTarget(renderer, layer.texture) != 0) {
+        supported = false;
+        return false;
+    }
+    state->drawColor(0, 0, 0, 0);
+    SDL_RenderClear(renderer);
+    return true;
+}
+
+void LayerCache::end(StaticLayer &layer, uint64_t signature)
+{
+    SDL_SetRenderTarget(renderer, prevTarget);
+    prevTarget = nullptr;
+    layer.signature = signature;
+    layer.valid = true;
+    ++rebuilds;
+}
+
+void LayerCache::clear()
+{
+    for (auto &kv : layers) {
+        if (!kv.second.texture) continue;
+        if (state) state->forget(kv.second.texture);
+        SDL_DestroyTexture(kv.second.texture);
+    }
+    layers.clear();
+}
@@ -0,0 +1,59 @@
+#pragma once
+#include <SDL2/SDL.h>
+#include <map>
+#include <cstdint>
+#include "renderstate.h"
+
+using namespace std;
+
+// Camada estática de um depth: os objetos marcados como estáticos daquele depth
+// já compostos numa textura do tamanho da tela.
+struct StaticLayer {
+    SDL_Texture *texture = nullptr;
+    uint64_t signature = 0;   // posição/imagem/FX dos membros quando foi montada
+    bool valid = false;
+};
+
+// Guarda uma render target por depth. A textura tem alpha pré-multiplicado
+// (o que foi desenhado com BLEND/ADD num fundo transparente), por isso é
+// composta com getCompositeBlend().
+class LayerCache {
+public:
+    LayerCache() = default;
+    ~LayerCache() { clear(); }
+
+    LayerCache(const LayerCache&) = delete;
+    LayerCache& operator=(const LayerCache&) = delete;
+
+    void setRenderer(SDL_Renderer *r, RenderState *s, int w, int h) { renderer = r; state = s; width = w; height = h; }
+
+    // nullptr se o renderer não suporta render target
+    StaticLayer* get(int depth);
+
+    // passa a desenhar na camada (limpa pra transparente) / volta pro alvo anterior
+    bool begin(StaticLayer &layer);
+    void end(StaticLayer &layer, uint64_t signature);
+
+    SDL_BlendMode getCompositeBlend() const { return composite; }
+
+    void clear();
+    // o conteúdo das texturas se perdeu (reset das render targets): remonta tudo
+    void invalidateAll() { for (auto &kv : layers) kv.second.valid = false; }
+    bool isSupported() const { return supported; }
+    void disable()           { supported = false; }   // backend sem render target
+    int  getRebuilds() const { return rebuilds; }
+    void resetStats()        { rebuilds = 0; }
+
+private:
+    SDL_Renderer *renderer = nullptr;
+    RenderState  *state    = nullptr;
+    int width = 0, height = 0;
+
+    map<int, StaticLayer> layers;
+    SDL_Texture *prevTarget = nullptr;
+    SDL_BlendMode composite = SDL_ComposeCustomBlendMode(
+        SDL_BLENDFACTOR_ONE, SDL_BLENDFACTOR_ONE_MINUS_SRC_ALPHA, SDL_BLENDOPERATION_ADD,
+        SDL_BLENDFACTOR_ONE, SDL_BLENDFACTOR_ONE_MINUS_SRC_ALPHA, SDL_BLENDOPERATION_ADD);
+    bool supported = true;   // a simulação lê a cópia em Engine::layersOn
+    int  rebuilds  = 0;
+};
@@ -0,0 +1,68 @@
+#include "mipmap.h"
+#include <algorithm>
+#include <cstdint>
+
+SDL_Surface* mipHalve(const SDL_Surface *src)
+{
+    const int sw = src->w, sh = src->h;
+    const int dw = max(1, sw / 2), dh = max(1, sh / 2);
+    SDL_Surface *dst = SDL_CreateRGBSurfaceWithFormat(0, dw, dh, 32, SDL_PIXELFORMAT_ARGB8888);
+    if (!dst) return nullptr;
+
+    for (int y = 0; y < dh; ++y) {
+        // lado ímpar: a última linha/coluna de origem é reaproveitada
+        const int y0 = min(y * 2, sh - 1), y1 = min(y * 2 + 1, sh - 1);
+        const uint32_t *r0 = (const uint32_t*)((const uint8_t*)src->pixels + size_t(y0) * src->pitch);
+        const uint32_t *r1 = (const uint32_t*)((const uint8_t*)src->pixels + size_t(y1) * src->pitch);
+        uint32_t *out = (uint32_t*)((uint8_t*)dst->pixels + size_t(y) * dst->pitch);
+
+        for (int x = 0; x < dw; ++x) {
+            const int x0 = min(x * 2, sw - 1), x1 = min(x * 2 + 1, sw - 1);
+            const uint32_t p[4] = { r0[x0], r0[x1], r1[x0], r1[x1] };
+
+            uint32_t a = 0, r = 0, g = 0, b = 0;
+            for (uint32_t c : p) {
+                const uint32_t ca = c >> 24;
+                a += ca;
+                r += ((c >> 16) & 0xFF) * ca;
+                g += ((c >> 8) & 0xFF) * ca;
+                b += (c & 0xFF) * ca;
+            }
+            if (a == 0) {
+                out[x] = 0;
+                continue;
+            }
+            out[x] = (((a + 2) / 4) << 24) | (((r + a / 2) / a) << 16) |
+                     (((g + a / 2) / a) << 8) | ((b + a / 2) / a);
+        }
+    }
+    return dst;
+}
+
+vector<SDL_Surface*> buildMipChain(SDL_Surface *surface, float maxScale, int minSize)
+{
+    vector<SDL_Surface*> chain;
+    SDL_Surface *level = SDL_ConvertSurfaceFormat(surface, SDL_PIXELFORMAT_ARGB8888, 0);
+    const int fullW = surface->w, fullH = surface->h;
+    SDL_FreeSurface(surface);
+    if (!level) return chain;
+
+    // maior tamanho pedido na tela: o primeiro nível mantido ainda cobre ele
+    const float scale = min(1.0f, max(maxScale, 0.0f));
+    const int needW = max(1, int(fullW * scale + 0.999f));
+    const int needH = max(1, int(fullH * scale + 0.999f));
+
+    for (;;) {
+        const bool keep = !chain.empty() || level->w / 2 < needW || level->h / 2 < needH;
+        if (keep) chain.push_back(level);
+
+        SDL_Surface *next = min(level->w, level->h) / 2 < minSize ? nullptr : mipHalve(level);
+        if (!next) {
+            if (!keep) chain.push_back(level);   // minSize acima do tamanho pedido
+            break;
+        }
+        if (!keep) SDL_FreeSurface(level);
+        level = next;
+    }
+    return chain;
+}
@@ -0,0 +1,18 @@
+#pragma once
+#include <SDL2/SDL.h>
+#include <vector>
+
+using namespace std;
+
+// Cadeia de mips feita na CPU no carregamento. Cada nível tem metade do
+// anterior (arredondando pra baixo, mínimo 1), com filtro box 2x2 ponderado
+// pelo alpha: pixels transparentes não escurecem a borda do sprite.
+
+// Metade do tamanho. Entrada e saída ARGB8888; nova superfície (quem chama libera)
+SDL_Surface* mipHalve(const SDL_Surface *src);
+
+// Converte `surface` pra ARGB8888 (libera a original) e gera os níveis até o
+// lado menor ficar abaixo de minSize. maxScale < 1 diz o maior tamanho em que a
+// imagem aparece na tela: os níveis maiores que isso são descartados.
+// [0] é o maior nível mantido; vazio se a conversão falhar.
+vector<SDL_Surface*> buildMipChain(SDL_Surface *surface, float maxScale = 1.0f, int minSize = 8);
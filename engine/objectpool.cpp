@@ -0,0 +1,47 @@
+#include "objectpool.h"
+#include <algorithm>
+#include <new>
+
+Object* ObjectPool::acquire()
+{
+    Object *obj = nullptr;
+    if (!freeList.empty()) {
+        obj = freeList.back();
+        freeList.pop_back();
+    } else {
+        if (chunks.empty() || chunks.back()->used == CHUNK) {
+            chunks.push_back(unique_ptr<Chunk>(new Chunk));   // sem zerar os bytes
+            stats.chunks   = (int)chunks.size();
+            stats.capacity = stats.chunks * CHUNK;
+            stats.bytes    = size_t(stats.capacity) * sizeof(Object);
+            freeList.reserve(stats.capacity);   // release() não aloca
+        }
+        Chunk &chunk = *chunks.back();
+        obj = new (chunk.at(chunk.used)) Object(0, 0, 0, 0);
+        chunk.used++;
+    }
+
+    stats.live++;
+    stats.pooled    = (int)freeList.size();
+    stats.highWater = max(stats.highWater, stats.live);
+    return obj;
+}
+
+void ObjectPool::release(Object *obj)
+{
+    if (!obj) return;
+    freeList.push_back(obj);
+    stats.live--;
+    stats.pooled = (int)freeList.size();
+}
+
+void ObjectPool::clear()
+{
+    freeList.clear();
+    for (auto &chunk : chunks)
+        for (int i = 0; i < chunk->used; ++i) chunk->at(i)->~Object();
+    chunks.clear();
+    const int highWater = stats.highWater;
+    stats = ObjectPoolStats{};
+    stats.highWater = highWater;
+}
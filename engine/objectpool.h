@@ -0,0 +1,54 @@
+#pragma once
+#include <vector>
+#include <memory>
+#include <cstddef>
+#include "gameobject.h"
+
+using namespace std;
+
+// Contadores do pool de objetos
+struct ObjectPoolStats {
+    int    live      = 0;   // objetos em uso
+    int    pooled    = 0;   // construídos e parados na lista livre
+    int    capacity  = 0;   // vagas em todos os blocos
+    int    highWater = 0;   // pico de objetos vivos
+    int    chunks    = 0;
+    size_t bytes     = 0;   // memória dos blocos (sem o que cada objeto aloca)
+};
+
+// Objetos em blocos contíguos de CHUNK, reaproveitados por lista livre.
+// Um objeto devolvido não é destruído: o Object::reset limpa os vetores
+// (alarmes, imagens) e strings sem devolver a capacidade, então um objeto
+// reciclado não aloca de novo pra repetir o que o anterior fazia.
+// Destrutores só rodam no clear() (ou com o pool).
+class ObjectPool {
+public:
+    static constexpr int CHUNK = 256;
+
+    ObjectPool() = default;
+    ~ObjectPool() { clear(); }
+
+    ObjectPool(const ObjectPool&) = delete;
+    ObjectPool& operator=(const ObjectPool&) = delete;
+
+    // objeto já construído; quem pega chama reset() com os valores dele
+    Object* acquire();
+    // o objeto já deve ter passado pelo reset() (sem engine, sem imagens)
+    void release(Object *obj);
+    void clear();
+
+    const ObjectPoolStats& getStats() const { return stats; }
+
+private:
+    // Memória crua de CHUNK objetos, construídos no lugar conforme são pedidos
+    // (Object não copia nem move, então não cabe num vector<Object>)
+    struct Chunk {
+        alignas(Object) unsigned char bytes[CHUNK * sizeof(Object)];
+        int used = 0;
+        Object* at(int i) { return reinterpret_cast<Object*>(bytes) + i; }
+    };
+
+    vector<unique_ptr<Chunk>> chunks;   // endereços fixos
+    vector<Object*> freeList;
+    ObjectPoolStats stats;
+};
@@ -0,0 +1,114 @@
+#include "particles.h"
+#include <algorithm>
+
+void ParticleEmitter::emit(const Particle &p)
+{
+    x.push_back(p.x);
+    y.push_back(p.y);
+    vx.push_back(p.vx);
+    vy.push_back(p.vy);
+    angle.push_back(p.angle);
+    spin.push_back(p.spin);
+    w.push_back(p.w);
+    h.push_back(p.h);
+    life.push_back(p.life);
+    lifeStart.push_back(p.life > 0 ? p.life : 1);
+    frame.push_back(p.frame);
+    tint.push_back(p.tint);
+}
+
+void ParticleEmitter::update()
+{
+    const size_t n = x.size();
+    if (n == 0) return;
+
+    float *px = x.data(), *py = y.data(), *pvx = vx.data(), *pvy = vy.data();
+    float *pa = angle.data(), *ps = spin.data();
+    int32_t *pl = life.data();
+
+    for (size_t i = 0; i < n; ++i) px[i] += pvx[i];
+    for (size_t i = 0; i < n; ++i) py[i] += pvy[i];
+    if (gravity != 0.0f)
+        for (size_t i = 0; i < n; ++i) pvy[i] += gravity;
+    for (size_t i = 0; i < n; ++i) {
+        float a = pa[i] + ps[i];
+        pa[i] = a >= 360.0f ? a - 360.0f : (a < 0.0f ? a + 360.0f : a);
+    }
+    bool dead = false;
+    for (size_t i = 0; i < n; ++i) dead |= --pl[i] <= 0;
+
+    if (dead) removeDead();
+}
+
+// troca cada morta pela última viva (a ordem entre partículas não importa)
+void ParticleEmitter::removeDead()
+{
+    size_t n = x.size();
+    for (size_t i = 0; i < n; ) {
+        if (life[i] > 0) { ++i; continue; }
+        --n;
+        x[i] = x[n]; y[i] = y[n]; vx[i] = vx[n]; vy[i] = vy[n];
+        angle[i] = angle[n]; spin[i] = spin[n]; w[i] = w[n]; h[i] = h[n];
+        life[i] = life[n]; lifeStart[i] = lifeStart[n]; frame[i] = frame[n]; tint[i] = tint[n];
+    }
+    x.resize(n); y.resize(n); vx.resize(n); vy.resize(n);
+    angle.resize(n); spin.resize(n); w.resize(n); h.resize(n);
+    life.resize(n); lifeStart.resize(n); frame.resize(n); tint.resize(n);
+}
+
+void ParticleEmitter::clear()
+{
+    x.clear(); y.clear(); vx.clear(); vy.clear();
+    angle.clear(); spin.clear(); w.clear(); h.clear();
+    life.clear(); lifeStart.clear(); frame.clear(); tint.clear();
+}
+
+EmitterId ParticleSystem::create(int depth, const FxParams &fx)
+{
+    auto e = make_unique<ParticleEmitter>();
+    e->depth = depth;
+    e->fx    = fx;
+    emitters.push_back(move(e));
+    sorted.clear();
+    EmitterId id;
+    id.index = (int32_t)emitters.size() - 1;
+    return id;
+}
+
+void ParticleSystem::beginStep()
+{
+    for (auto &e : emitters) {
+        e->prevOriginX = e->originX;
+        e->prevOriginY = e->originY;
+    }
+}
+
+void ParticleSystem::update()
+{
+    for (auto &e : emitters) e->update();
+}
+
+void ParticleSystem::clear()
+{
+    for (auto &e : emitters) e->clear();
+}
+
+size_t ParticleSystem::count() const
+{
+    size_t n = 0;
+    for (auto &e : emitters) n += e->size();
+    return n;
+}
+
+const vector<ParticleEmitter*>& ParticleSystem::byDepth()
+{
+    if (sorted.size() != emitters.size()) {
+        sorted.clear();
+        for (auto &e : emitters) sorted.push_back(e.get());
+    }
+    // depth é público e pode mudar; poucos emissores, ordenar é barato
+    stable_sort(sorted.begin(), sorted.end(), [](const ParticleEmitter *a, const ParticleEmitter *b) {
+        return a->depth > b->depth;
+    });
+    return sorted;
+}
@@ -0,0 +1,72 @@
+#pragma once
+#include <vector>
+#include <memory>
+#include <cstdint>
+#include "handles.h"
+#include "gameobject.h"
+
+using namespace std;
+
+// Dados de uma partícula nova (só pra emitir; guardado em SoA no emissor)
+struct Particle {
+    float     x = 0, y = 0;          // centro (relativo à origem do emissor)
+    float     vx = 0, vy = 0;        // por passo
+    float     angle = 0, spin = 0;   // graus, graus por passo
+    float     w = 0, h = 0;
+    int       life = 60;             // passos
+    TextureId frame;
+    Color     tint{255, 255, 255, 255};
+};
+
+// Emissor: partículas em structure-of-arrays, atualizadas em laços simples
+// (um por campo) e desenhadas como uma única sequência SPRITES no depth do
+// emissor. Todas compartilham blend/glow (fx); por partícula só imagem e cor.
+class ParticleEmitter {
+public:
+    int      depth = 0;
+    FxParams fx;
+    float    gravity = 0.0f;     // somado a vy a cada passo
+    float    originX = 0.0f;     // origem das posições (emissor preso a um objeto)
+    float    originY = 0.0f;
+    bool     visible = true;
+    bool     fadeOut = false;    // alpha cai com a vida restante
+
+    void emit(const Particle &p);
+    void update();               // um passo da simulação
+    void clear();
+    size_t size() const { return x.size(); }
+
+    void setOrigin(float ox, float oy) { originX = ox; originY = oy; }
+    float prevOriginX = 0.0f, prevOriginY = 0.0f;   // origem no começo do passo (interpolação)
+
+    // SoA (leitura no desenho)
+    vector<float>     x, y, vx, vy, angle, spin, w, h;
+    vector<int32_t>   life, lifeStart;
+    vector<TextureId> frame;
+    vector<Color>     tint;
+
+private:
+    void removeDead();
+};
+
+// Todos os emissores da Engine. O handle é o índice; emissores não são
+// destruídos (o jogo cria poucos, no início).
+class ParticleSystem {
+public:
+    EmitterId create(int depth, const FxParams &fx = FxParams{});
+    ParticleEmitter* get(EmitterId id) {
+        return id.valid() && id.index < (int32_t)emitters.size() ? emitters[id.index].get() : nullptr;
+    }
+
+    void beginStep();          // antes dos objetos: guarda as origens
+    void update();             // depois dos objetos
+    void clear();              // esvazia as partículas (emissores continuam)
+    size_t count() const;
+
+    // ordem de desenho: depth maior primeiro, como os objetos
+    const vector<ParticleEmitter*>& byDepth();
+
+private:
+    vector<unique_ptr<ParticleEmitter>> emitters;
+    vector<ParticleEmitter*> sorted;
+};
@@ -0,0 +1,168 @@
+#include "primitivebatch.h"
+#include <algorithm>
+#include <cmath>
+
+static inline bool sameColor(SDL_Color a, SDL_Color b) {
+    return a.r == b.r && a.g == b.g && a.b == b.b && a.a == b.a;
+}
+
+PrimitiveBatch::Run& PrimitiveBatch::trianglesRun()
+{
+    if (runs.empty() || runs.back().kind != TRIANGLES)
+        runs.push_back(Run{ TRIANGLES, SDL_Color{0, 0, 0, 0}, (int)verts.size(), 0, (int)indices.size(), 0 });
+    return runs.back();
+}
+
+// merge = continua a sequência anterior (mesmo tipo e cor); linhas só emendam
+// quando o ponto inicial coincide com o último, quem decide é o chamador
+PrimitiveBatch::Run& PrimitiveBatch::pointsRun(Kind kind, SDL_Color c, bool merge)
+{
+    if (!merge || runs.empty() || runs.back().kind != kind || !sameColor(runs.back().color, c))
+        runs.push_back(Run{ kind, c, (int)points.size(), 0, 0, 0 });
+    return runs.back();
+}
+
+void PrimitiveBatch::quad(float x0, float y0, float x1, float y1, SDL_Color c)
+{
+    Run &run = trianglesRun();
+    const int base = (int)verts.size() - run.first;
+    verts.push_back({ { x0, y0 }, c, { 0, 0 } });
+    verts.push_back({ { x1, y0 }, c, { 0, 0 } });
+    verts.push_back({ { x1, y1 }, c, { 0, 0 } });
+    verts.push_back({ { x0, y1 }, c, { 0, 0 } });
+    indices.insert(indices.end(), { base, base + 1, base + 2, base, base + 2, base + 3 });
+    run.count      += 4;
+    run.indexCount += 6;
+}
+
+void PrimitiveBatch::fillRect(int x, int y, int w, int h, SDL_Color c)
+{
+    if (w <= 0 || h <= 0) return;
+    quad(float(x), float(y), float(x + w), float(y + h), c);
+}
+
+void PrimitiveBatch::rect(int x, int y, int w, int h, SDL_Color c)
+{
+    if (w <= 0 || h <= 0) return;
+    fillRect(x, y, w, 1, c);                       // topo
+    if (h > 1) fillRect(x, y + h - 1, w, 1, c);    // base
+    fillRect(x, y + 1, 1, h - 2, c);               // esquerda
+    if (w > 1) fillRect(x + w - 1, y + 1, 1, h - 2, c);
+}
+
+void PrimitiveBatch::line(int x1, int y1, int x2, int y2, SDL_Color c)
+{
+    // horizontais/verticais viram retângulos de 1px (mesmos pixels, extremos inclusos)
+    if (y1 == y2) {
+        fillRect(min(x1, x2), y1, abs(x2 - x1) + 1, 1, c);
+        return;
+    }
+    if (x1 == x2) {
+        fillRect(x1, min(y1, y2), 1, abs(y2 - y1) + 1, c);
+        return;
+    }
+
+    const bool continues = !runs.empty() && runs.back().kind == LINES && runs.back().count > 0 &&
+                           points.back().x == x1 && points.back().y == y1;
+    Run &run = pointsRun(LINES, c, continues);
+    if (run.count == 0) {
+        points.push_back(SDL_Point{ x1, y1 });
+        run.count++;
+    }
+    points.push_back(SDL_Point{ x2, y2 });
+    run.count++;
+}
+
+void PrimitiveBatch::polyline(const pair<int,int> *pts, size_t count, bool closed, SDL_Color c)
+{
+    if (count < 2) return;
+    Run &run = pointsRun(LINES, c, false);
+    for (size_t i = 0; i < count; ++i) points.push_back(SDL_Point{ pts[i].first, pts[i].second });
+    if (closed) points.push_back(SDL_Point{ pts[0].first, pts[0].second });
+    run.count = (int)points.size() - run.first;
+}
+
+void PrimitiveBatch::point(int x, int y, SDL_Color c)
+{
+    Run &run = pointsRun(POINTS, c, true);
+    points.push_back(SDL_Point{ x, y });
+    run.count++;
+}
+
+void PrimitiveBatch::fillCircle(int cx, int cy, int radius, SDL_Color c)
+{
+    if (radius <= 0) {
+        point(cx, cy, c);
+        return;
+    }
+    // segmentos de ~4px na borda, entre 12 e 128
+    const int segs = max(12, min(128, int(2.0 * M_PI * radius / 4.0)));
+    const float fx = cx + 0.5f, fy = cy + 0.5f, r = radius + 0.5f;
+
+    Run &run = trianglesRun();
+    const int base = (int)verts.size() - run.first;
+    verts.push_back({ { fx, fy }, c, { 0, 0 } });
+    for (int i = 0; i < segs; ++i) {
+        const float a = float(2.0 * M_PI * i / segs);
+        verts.push_back({ { fx + r * cosf(a), fy + r * sinf(a) }, c, { 0, 0 } });
+    }
+    for (int i = 0; i < segs; ++i) {
+        const int next = (i + 1) % segs;
+        indices.insert(indices.end(), { base, base + 1 + i, base + 1 + next });
+    }
+    run.count      += segs + 1;
+    run.indexCount += segs * 3;
+}
+
+void PrimitiveBatch::circle(int cx, int cy, int radius, SDL_Color c)
+{
+    Run &run = pointsRun(POINTS, c, true);
+    int x = radius, y = 0, err = 0;
+    while (x >= y) {
+        points.insert(points.end(), {
+            SDL_Point{ cx + x, cy + y }, SDL_Point{ cx + y, cy + x },
+            SDL_Point{ cx - y, cy + x }, SDL_Point{ cx - x, cy + y },
+            SDL_Point{ cx - x, cy - y }, SDL_Point{ cx - y, cy - x },
+            SDL_Point{ cx + y, cy - x }, SDL_Point{ cx + x, cy - y } });
+        run.count += 8;
+        if (err <= 0) { y += 1; err += 2*y + 1; }
+        if (err > 0)  { x -= 1; err -= 2*x + 1; }
+    }
+}
+
+int PrimitiveBatch::flush()
+{
+    if (runs.empty() || !renderer || !state) {
+        runs.clear();
+        verts.clear();
+        indices.clear();
+        points.clear();
+        return 0;
+    }
+
+    const int before = drawCalls;
+    for (const Run &run : runs) {
+        if (run.count == 0) continue;
+        switch (run.kind) {
+            case TRIANGLES:
+                SDL_RenderGeometry(renderer, nullptr, verts.data() + run.first, run.count,
+                                   indices.data() + run.firstIndex, run.indexCount);
+                break;
+            case LINES:
+                state->drawColor(run.color.r, run.color.g, run.color.b, run.color.a);
+                SDL_RenderDrawLines(renderer, points.data() + run.first, run.count);
+                break;
+            case POINTS:
+                state->drawColor(run.color.r, run.color.g, run.color.b, run.color.a);
+                SDL_RenderDrawPoints(renderer, points.data() + run.first, run.count);
+                break;
+        }
+        ++drawCalls;
+    }
+
+    runs.clear();
+    verts.clear();
+    indices.clear();
+    points.clear();
+    return drawCalls - before;
+}
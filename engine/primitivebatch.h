@@ -0,0 +1,58 @@
+#pragma once
+#include <SDL2/SDL.h>
+#include <vector>
+#include <utility>
+#include "renderstate.h"
+
+using namespace std;
+
+// Junta as primitivas (retângulos, linhas, círculos, pontos) até o próximo flush.
+// Tudo que vira triângulo (retângulos, linhas horizontais/verticais, círculos
+// cheios) leva a cor no vértice e sai num único SDL_RenderGeometry, mesmo com
+// cores diferentes. Linhas inclinadas e pontos são agrupados por cor em
+// SDL_RenderDrawLines/SDL_RenderDrawPoints. A ordem dos pedidos é mantida.
+class PrimitiveBatch {
+public:
+    void setRenderer(SDL_Renderer *r, RenderState *s) { renderer = r; state = s; }
+
+    void fillRect(int x, int y, int w, int h, SDL_Color c);
+    void rect(int x, int y, int w, int h, SDL_Color c);            // contorno, igual ao SDL_RenderDrawRect
+    void line(int x1, int y1, int x2, int y2, SDL_Color c);
+    void polyline(const pair<int,int> *pts, size_t count, bool closed, SDL_Color c);
+    void point(int x, int y, SDL_Color c);
+    void fillCircle(int cx, int cy, int radius, SDL_Color c);      // leque de triângulos
+    void circle(int cx, int cy, int radius, SDL_Color c);          // contorno (ponto médio)
+
+    bool empty() const { return runs.empty(); }
+
+    // Desenha tudo que está na fila. Retorna quantas chamadas de desenho foram feitas.
+    int flush();
+
+    // --- estatísticas (acumulam até resetStats) ---
+    int  getDrawCalls() const { return drawCalls; }
+    void resetStats()         { drawCalls = 0; }
+
+private:
+    enum Kind { TRIANGLES, LINES, POINTS };
+
+    // sequência contígua de um mesmo tipo; os índices são relativos a firstVert
+    struct Run {
+        Kind      kind;
+        SDL_Color color;       // LINES/POINTS (triângulos têm cor por vértice)
+        int first, count;      // vértices (TRIANGLES) ou pontos (LINES/POINTS)
+        int firstIndex, indexCount;
+    };
+
+    SDL_Renderer      *renderer = nullptr;
+    RenderState       *state    = nullptr;
+    vector<Run>        runs;
+    vector<SDL_Vertex> verts;
+    vector<int>        indices;
+    vector<SDL_Point>  points;
+
+    int drawCalls = 0;
+
+    Run& trianglesRun();
+    Run& pointsRun(Kind kind, SDL_Color c, bool merge);
+    void quad(float x0, float y0, float x1, float y1, SDL_Color c);
+};
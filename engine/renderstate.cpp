@@ -0,0 +1,60 @@
+#include "renderstate.h"
+
+void RenderState::invalidate()
+{
+    textures.clear();
+    hasDrawColor = false;
+    hasDrawBlend = false;
+}
+
+bool RenderState::textureBlend(SDL_Texture *t, SDL_BlendMode mode)
+{
+    if (!t) return false;
+    TexState &s = textures[t];
+    if (s.hasBlend && s.blend == mode) { ++skipped; return true; }
+    if (SDL_SetTextureBlendMode(t, mode) != 0) return false;
+    s.blend = mode;
+    s.hasBlend = true;
+    ++applied;
+    return true;
+}
+
+void RenderState::textureColor(SDL_Texture *t, Uint8 r, Uint8 g, Uint8 b)
+{
+    if (!t) return;
+    TexState &s = textures[t];
+    if (s.hasColor && s.r == r && s.g == g && s.b == b) { ++skipped; return; }
+    SDL_SetTextureColorMod(t, r, g, b);
+    s.r = r; s.g = g; s.b = b;
+    s.hasColor = true;
+    ++applied;
+}
+
+void RenderState::textureAlpha(SDL_Texture *t, Uint8 a)
+{
+    if (!t) return;
+    TexState &s = textures[t];
+    if (s.hasAlpha && s.a == a) { ++skipped; return; }
+    SDL_SetTextureAlphaMod(t, a);
+    s.a = a;
+    s.hasAlpha = true;
+    ++applied;
+}
+
+void RenderState::drawColor(Uint8 r, Uint8 g, Uint8 b, Uint8 a)
+{
+    if (hasDrawColor && dr == r && dg == g && db == b && da == a) { ++skipped; return; }
+    SDL_SetRenderDrawColor(renderer, r, g, b, a);
+    dr = r; dg = g; db = b; da = a;
+    hasDrawColor = true;
+    ++applied;
+}
+
+void RenderState::drawBlend(SDL_BlendMode mode)
+{
+    if (hasDrawBlend && drawMode == mode) { ++skipped; return; }
+    SDL_SetRenderDrawBlendMode(renderer, mode);
+    drawMode = mode;
+    hasDrawBlend = true;
+    ++applied;
+}
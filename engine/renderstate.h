@@ -0,0 +1,46 @@
+#pragma once
+#include <SDL2/SDL.h>
+#include <unordered_map>
+
+using namespace std;
+
+// Sombra do estado do renderer: lembra o último blend/cor/alpha de cada textura
+// e a cor de desenho, e só chama o SDL quando o valor muda de verdade.
+// Quem destrói uma textura que passou por aqui deve chamar forget().
+class RenderState {
+public:
+    void setRenderer(SDL_Renderer *r) { renderer = r; invalidate(); }
+
+    bool textureBlend(SDL_Texture *t, SDL_BlendMode mode);  // false se o SDL recusou o modo
+    void textureColor(SDL_Texture *t, Uint8 r, Uint8 g, Uint8 b);
+    void textureAlpha(SDL_Texture *t, Uint8 a);
+
+    void drawColor(Uint8 r, Uint8 g, Uint8 b, Uint8 a);
+    void drawBlend(SDL_BlendMode mode);
+
+    void forget(SDL_Texture *t) { textures.erase(t); }
+    void invalidate();  // esquece tudo (próximas chamadas vão ao SDL)
+
+    // --- estatísticas (acumulam até resetStats) ---
+    int  getApplied() const { return applied; }
+    int  getSkipped() const { return skipped; }
+    void resetStats()       { applied = skipped = 0; }
+
+private:
+    struct TexState {
+        SDL_BlendMode blend = SDL_BLENDMODE_INVALID;
+        Uint8 r = 0, g = 0, b = 0, a = 0;
+        bool  hasBlend = false, hasColor = false, hasAlpha = false;
+    };
+
+    SDL_Renderer *renderer = nullptr;
+    unordered_map<SDL_Texture*, TexState> textures;
+
+    Uint8 dr = 0, dg = 0, db = 0, da = 0;
+    bool  hasDrawColor = false;
+    SDL_BlendMode drawMode = SDL_BLENDMODE_INVALID;
+    bool  hasDrawBlend = false;
+
+    int applied = 0;
+    int skipped = 0;
+};
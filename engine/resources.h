@@ -3,6 +3,29 @@
 #include <SDL2/SDL.h>
 #include <SDL2/SDL_image.h>
 #include <SDL2/SDL_mixer.h>
+#include <string>
+#include <vector>
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+#include "handles.h"
+
+// Contador de referências copiável (o vetor de recursos copia/move as entradas).
+// Objetos mexem nele na thread da simulação; o despejo lê na thread principal
+struct RefCount {
+    std::atomic<int> n{0};
+    RefCount() = default;
+    RefCount(const RefCount &o) : n(o.n.load()) {}
+    RefCount& operator=(const RefCount &o) { n = o.n.load(); return *this; }
+};
+
+// Nível reduzido de uma imagem (mip): metade do anterior, filtrado na CPU
+struct MipLevel {
+    SDL_Texture *texture = nullptr;
+    SDL_Surface *surface = nullptr;
+    SDL_Rect     src{0, 0, 0, 0};
+    bool         owns = false;     // false quando está numa página do atlas
+};
 
 class GameResource {
 public:
@@ -10,17 +33,82 @@ public:
     
     Type type;
     SDL_Texture *texture;
+    SDL_Rect src;          // região da imagem dentro da textura (maior nível carregado)
+    SDL_Point size;        // tamanho nominal (do arquivo): o que objetos e a simulação usam
+    bool ownsTexture;      // false quando a textura é uma página do atlas
+    SDL_Surface *surface;  // pixels ARGB8888 do backend de software (no lugar da textura)
     Mix_Chunk *sound;
     Mix_Music *music;
+    std::string tag;       // nome usado na API por string
+    std::string path;      // imagem registrada sem carregar: arquivo lido no primeiro uso
+    int32_t base;          // parte de outra imagem: índice da imagem dona dos pixels
+    SDL_Rect part;         // parte: retângulo na imagem dona, em coordenadas nominais
+    float maxScale;        // maior escala em que aparece: níveis acima disso nem são carregados
+    std::vector<MipLevel> mips;   // níveis menores que src, do maior pro menor
+    RefCount refs;         // objetos usando a imagem (uma parte também segura a base)
+    uint64_t lastUsed;     // último frame em que foi desenhada (ordem do despejo LRU)
     
-    GameResource() : type(NONE), texture(nullptr), sound(nullptr) {}
+    GameResource() : type(NONE), texture(nullptr), src{0, 0, 0, 0}, size{0, 0}, ownsTexture(false),
+                     surface(nullptr), sound(nullptr), music(nullptr), base(-1), part{0, 0, 0, 0},
+                     maxScale(1.0f), lastUsed(0) {}
     
     static GameResource CreateTexture(SDL_Texture* tex) {
         GameResource res;
         res.type = TEXTURE;
         res.texture = tex;
+        res.ownsTexture = true;
+        if (tex) SDL_QueryTexture(tex, nullptr, nullptr, &res.src.w, &res.src.h);
+        res.size = SDL_Point{ res.src.w, res.src.h };
+        return res;
+    }
+
+    // imagem empacotada numa página compartilhada
+    static GameResource CreateTextureRegion(SDL_Texture* page, const SDL_Rect& region) {
+        GameResource res;
+        res.type = TEXTURE;
+        res.texture = page;
+        res.src = region;
+        res.size = SDL_Point{ region.w, region.h };
+        res.ownsTexture = false;
+        return res;
+    }
+    
+    // imagem em memória para o rasterizador de CPU
+    static GameResource CreateSurface(SDL_Surface* surf) {
+        GameResource res;
+        res.type = TEXTURE;
+        res.surface = surf;
+        res.ownsTexture = true;
+        if (surf) res.src = SDL_Rect{ 0, 0, surf->w, surf->h };
+        res.size = SDL_Point{ res.src.w, res.src.h };
+        return res;
+    }
+    
+    // só o tamanho; os pixels chegam no primeiro uso (ou pelo prefetch)
+    static GameResource CreateLazy(const std::string& file, int w, int h) {
+        GameResource res;
+        res.type = TEXTURE;
+        res.path = file;
+        res.src = SDL_Rect{ 0, 0, w, h };
+        res.size = SDL_Point{ w, h };
+        return res;
+    }
+
+    // janela numa imagem (splitImage); os pixels são ligados quando a dona está carregada
+    static GameResource CreatePart(int32_t baseIndex, const SDL_Rect& region) {
+        GameResource res;
+        res.type = TEXTURE;
+        res.base = baseIndex;
+        res.part = region;
+        res.src = region;
+        res.size = SDL_Point{ region.w, region.h };
         return res;
     }
+
+    // registrada (ou despejada) e sem pixels agora
+    bool isLazy() const {
+        return type == TEXTURE && !texture && !surface && (!path.empty() || base >= 0);
+    }
     
     static GameResource CreateSound(Mix_Chunk* snd) {
         GameResource res;
@@ -36,9 +124,52 @@ public:
         return res;
     }
 
+    // bytes de pixels que a entrada é dona (regiões do atlas e partes não contam)
+    size_t bytes() const {
+        if (type == SOUND && sound) return sound->alen;
+        if (type != TEXTURE) return 0;
+        size_t total = 0;
+        if (ownsTexture && surface) total += size_t(surface->pitch) * surface->h;
+        else if (ownsTexture && texture) total += size_t(src.w) * src.h * 4;
+        for (const MipLevel &m : mips)
+            if (m.owns) total += size_t(m.src.w) * m.src.h * 4;
+        return total;
+    }
+
     bool isValid() const {
-        return (type == TEXTURE && texture != nullptr) ||
+        return (type == TEXTURE && (texture != nullptr || surface != nullptr || isLazy())) ||
                (type == SOUND   && sound   != nullptr) ||
                (type == MUSIC   && music   != nullptr);
     }
-};
\ No newline at end of file
+};
+
+// Nível que vai ser amostrado pra desenhar a imagem em w x h: o menor que ainda
+// cobre o destino (sem ampliar). Partes recortam o mesmo nível da imagem dona.
+inline MipLevel pickMipLevel(const std::vector<GameResource> &textures, int32_t index, int w, int h)
+{
+    const GameResource &res   = textures[index];
+    const GameResource &owner = res.base >= 0 ? textures[res.base] : res;
+
+    auto cut = [&](const MipLevel &lv) {
+        MipLevel out = lv;
+        if (res.base >= 0 && owner.size.x > 0 && owner.size.y > 0) {
+            const float sx = float(lv.src.w) / owner.size.x;
+            const float sy = float(lv.src.h) / owner.size.y;
+            out.src = SDL_Rect{ lv.src.x + int(res.part.x * sx), lv.src.y + int(res.part.y * sy),
+                                std::max(1, int(res.part.w * sx)), std::max(1, int(res.part.h * sy)) };
+        }
+        return out;
+    };
+
+    MipLevel level0;
+    level0.texture = owner.texture;
+    level0.surface = owner.surface;
+    level0.src     = owner.src;
+    MipLevel best = cut(level0);
+    for (const MipLevel &lv : owner.mips) {
+        const MipLevel c = cut(lv);
+        if (c.src.w < w || c.src.h < h) break;
+        best = c;
+    }
+    return best;
+}
@@ -0,0 +1,120 @@
+#include "softblend.h"
+#include <SDL2/SDL.h>
+#include <cstring>
+
+// canal c (0 = B, 1 = G, 2 = R, 3 = A)
+static inline uint32_t ch(uint32_t p, int c) { return (p >> (8 * c)) & 0xFF; }
+
+static inline uint32_t modulated(uint32_t s, uint32_t mod, int c) {
+    return softDiv255(ch(s, c) * ch(mod, c));
+}
+
+static void spanNormal(uint32_t *dst, const uint32_t *src, int count, uint32_t mod)
+{
+    for (int i = 0; i < count; ++i) {
+        const uint32_t d = dst[i];
+        const uint32_t sa = modulated(src[i], mod, 3);
+        const uint32_t inv = 255 - sa;
+        uint32_t out = 0;
+        for (int c = 0; c < 3; ++c)
+            out |= softDiv255(modulated(src[i], mod, c) * sa + ch(d, c) * inv) << (8 * c);
+        out |= softDiv255(sa * 255 + ch(d, 3) * inv) << 24;
+        dst[i] = out;
+    }
+}
+
+static void spanAdd(uint32_t *dst, const uint32_t *src, int count, uint32_t mod)
+{
+    for (int i = 0; i < count; ++i) {
+        const uint32_t d = dst[i];
+        const uint32_t sa = modulated(src[i], mod, 3);
+        uint32_t out = d & 0xFF000000u;
+        for (int c = 0; c < 3; ++c) {
+            uint32_t v = ch(d, c) + softDiv255(modulated(src[i], mod, c) * sa);
+            out |= (v > 255 ? 255 : v) << (8 * c);
+        }
+        dst[i] = out;
+    }
+}
+
+static void spanMod(uint32_t *dst, const uint32_t *src, int count, uint32_t mod)
+{
+    for (int i = 0; i < count; ++i) {
+        const uint32_t d = dst[i];
+        uint32_t out = d & 0xFF000000u;
+        for (int c = 0; c < 3; ++c)
+            out |= softDiv255(modulated(src[i], mod, c) * ch(d, c)) << (8 * c);
+        dst[i] = out;
+    }
+}
+
+static void spanMul(uint32_t *dst, const uint32_t *src, int count, uint32_t mod)
+{
+    for (int i = 0; i < count; ++i) {
+        const uint32_t d = dst[i];
+        const uint32_t inv = 255 - modulated(src[i], mod, 3);
+        uint32_t out = d & 0xFF000000u;
+        for (int c = 0; c < 3; ++c) {
+            uint32_t v = softDiv255(modulated(src[i], mod, c) * ch(d, c)) + softDiv255(ch(d, c) * inv);
+            out |= (v > 255 ? 255 : v) << (8 * c);
+        }
+        dst[i] = out;
+    }
+}
+
+static void spanScreen(uint32_t *dst, const uint32_t *src, int count, uint32_t mod)
+{
+    for (int i = 0; i < count; ++i) {
+        const uint32_t d = dst[i];
+        uint32_t out = 0;
+        for (int c = 0; c < 4; ++c) {
+            const uint32_t s = modulated(src[i], mod, c);
+            out |= (s + softDiv255(ch(d, c) * (255 - s))) << (8 * c);
+        }
+        dst[i] = out;
+    }
+}
+
+const BlendKernels& blendKernelsScalar()
+{
+    static const BlendKernels k = { "scalar", { spanNormal, spanAdd, spanMod, spanMul, spanScreen } };
+    return k;
+}
+
+#if !defined(ENGINE_HAVE_SSE2)
+const BlendKernels* blendKernelsSSE2() { return nullptr; }
+#endif
+#if !defined(ENGINE_HAVE_AVX2)
+const BlendKernels* blendKernelsAVX2() { return nullptr; }
+#endif
+
+static const BlendKernels *activeKernels = nullptr;
+
+bool selectBlendKernels(SoftIsa isa)
+{
+    const BlendKernels *sse2 = SDL_HasSSE2() ? blendKernelsSSE2() : nullptr;
+    const BlendKernels *avx2 = SDL_HasAVX2() ? blendKernelsAVX2() : nullptr;
+
+    switch (isa) {
+        case SoftIsa::Scalar: activeKernels = &blendKernelsScalar(); return true;
+        case SoftIsa::SSE2:   if (!sse2) return false; activeKernels = sse2; return true;
+        case SoftIsa::AVX2:   if (!avx2) return false; activeKernels = avx2; return true;
+        case SoftIsa::Auto:   break;
+    }
+    activeKernels = avx2 ? avx2 : sse2 ? sse2 : &blendKernelsScalar();
+    return true;
+}
+
+const BlendKernels& blendKernels()
+{
+    if (!activeKernels) {
+        SoftIsa isa = SoftIsa::Auto;
+        if (const char *env = SDL_getenv("ENGINE_SIMD")) {
+            if      (strcmp(env, "scalar") == 0) isa = SoftIsa::Scalar;
+            else if (strcmp(env, "sse2") == 0)   isa = SoftIsa::SSE2;
+            else if (strcmp(env, "avx2") == 0)   isa = SoftIsa::AVX2;
+        }
+        if (!selectBlendKernels(isa)) selectBlendKernels(SoftIsa::Auto);
+    }
+    return *activeKernels;
+}
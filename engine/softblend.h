@@ -0,0 +1,41 @@
+#pragma once
+#include <cstdint>
+
+// Kernels de blend do renderer por software. Pixels ARGB8888 (na memória: B, G, R, A),
+// sem alpha pré-multiplicado, com as mesmas equações dos modos do SDL:
+//   Normal: rgb = s*sa + d*(1-sa)           a = sa + da*(1-sa)
+//   Add:    rgb = min(1, d + s*sa)          a = da
+//   Mod:    rgb = s*d                       a = da
+//   Mul:    rgb = min(1, s*d + d*(1-sa))    a = da
+//   Screen: rgb = s + d*(1-s)               a = sa + da*(1-sa)
+// onde s = pixel de origem * modulate (tint rgb + alpha mod).
+// As versões SSE2/AVX2 usam exatamente a mesma aritmética inteira da escalar,
+// então o resultado é idêntico bit a bit em qualquer máquina.
+
+enum class SoftBlend : uint8_t { Normal = 0, Add, Mod, Mul, Screen, Count };
+
+// dst[i] = blend(dst[i], src[i] * modulate), count pixels
+using BlendSpanFn = void (*)(uint32_t *dst, const uint32_t *src, int count, uint32_t modulate);
+
+struct BlendKernels {
+    const char *name;
+    BlendSpanFn span[(int)SoftBlend::Count];
+};
+
+enum class SoftIsa : uint8_t { Auto, Scalar, SSE2, AVX2 };
+
+// Tabela escolhida em tempo de execução (a melhor que a CPU suporta, ou a
+// forçada por selectBlendKernels / variável de ambiente ENGINE_SIMD=scalar|sse2|avx2).
+const BlendKernels& blendKernels();
+bool selectBlendKernels(SoftIsa isa);   // false se a CPU/compilação não tem o conjunto
+
+// Tabelas por conjunto de instruções (nullptr se não compilado)
+const BlendKernels& blendKernelsScalar();
+const BlendKernels* blendKernelsSSE2();
+const BlendKernels* blendKernelsAVX2();
+
+// x/255 arredondado, exato pra 0 <= x <= 255*255 (mesma fórmula nos kernels SIMD)
+static inline uint32_t softDiv255(uint32_t x) {
+    x += 128;
+    return (x + (x >> 8)) >> 8;
+}
@@ -0,0 +1,44 @@
+// Kernels AVX2: 8 pixels por iteração. Este arquivo é compilado com -mavx2
+// (/arch:AVX2), mas só é chamado se SDL_HasAVX2() confirmar em tempo de execução.
+#if defined(ENGINE_HAVE_AVX2)
+#include <immintrin.h>
+#include "softblend_simd.h"
+
+namespace {
+
+// unpack/pack/shuffle do AVX2 trabalham em cada metade de 128 bits, mas como
+// desempacota e empacota do mesmo jeito, os pixels voltam pro lugar certo
+struct Avx2 {
+    using V = __m256i;
+    static constexpr int N = 8;
+
+    static inline V load(const uint32_t *p)  { return _mm256_loadu_si256((const __m256i*)p); }
+    static inline void store(uint32_t *p, V v) { _mm256_storeu_si256((__m256i*)p, v); }
+    static inline V zero()              { return _mm256_setzero_si256(); }
+    static inline V set32(uint32_t v)   { return _mm256_set1_epi32((int)v); }
+    static inline V set16(uint16_t v)   { return _mm256_set1_epi16((short)v); }
+    static inline V unpacklo8(V a, V b) { return _mm256_unpacklo_epi8(a, b); }
+    static inline V unpackhi8(V a, V b) { return _mm256_unpackhi_epi8(a, b); }
+    static inline V packus16(V a, V b)  { return _mm256_packus_epi16(a, b); }
+    static inline V add16(V a, V b)     { return _mm256_add_epi16(a, b); }
+    static inline V sub16(V a, V b)     { return _mm256_sub_epi16(a, b); }
+    static inline V mul16(V a, V b)     { return _mm256_mullo_epi16(a, b); }
+    static inline V srl8(V a)           { return _mm256_srli_epi16(a, 8); }
+    static inline V and_(V a, V b)      { return _mm256_and_si256(a, b); }
+    static inline V or_(V a, V b)       { return _mm256_or_si256(a, b); }
+    static inline V andnot(V a, V b)    { return _mm256_andnot_si256(a, b); }
+    static inline V alpha16(V a) {
+        return _mm256_shufflehi_epi16(_mm256_shufflelo_epi16(a, _MM_SHUFFLE(3, 3, 3, 3)), _MM_SHUFFLE(3, 3, 3, 3));
+    }
+    static inline V rgbMask16() {
+        return _mm256_set_epi16(0, -1, -1, -1, 0, -1, -1, -1, 0, -1, -1, -1, 0, -1, -1, -1);
+    }
+    static inline V alpha255_16() {
+        return _mm256_set_epi16(255, 0, 0, 0, 255, 0, 0, 0, 255, 0, 0, 0, 255, 0, 0, 0);
+    }
+};
+
+} // namespace
+
+const BlendKernels* blendKernelsAVX2() { return &SimdBlend<Avx2>::table("avx2"); }
+#endif
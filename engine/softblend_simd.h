@@ -0,0 +1,75 @@
+#pragma once
+// Corpo dos kernels SIMD, incluído por softblend_sse2.cpp e softblend_avx2.cpp
+// depois de definirem o struct de instruções `Isa` (V, N, load/store, operações
+// em lanes de 16 bits). Cada pixel vira 4 lanes de 16 bits (B, G, R, A) e a
+// conta é a mesma da versão escalar.
+#include "softblend.h"
+
+namespace {
+
+template <class I>
+struct SimdBlend {
+    using V = typename I::V;
+
+    static inline V div255(V x) {
+        x = I::add16(x, I::set16(128));
+        return I::srl8(I::add16(x, I::srl8(x)));
+    }
+
+    // s já modulado; devolve o resultado em lanes de 16 bits
+    static inline V normal(V s, V d) {
+        const V sa  = I::alpha16(s);
+        const V inv = I::sub16(I::set16(255), sa);
+        const V f   = I::or_(I::and_(sa, I::rgbMask16()), I::alpha255_16());   // (sa, sa, sa, 255)
+        return div255(I::add16(I::mul16(s, f), I::mul16(d, inv)));
+    }
+    static inline V add(V s, V d) {
+        return I::add16(d, div255(I::mul16(s, I::alpha16(s))));                // packus satura em 255
+    }
+    static inline V mod(V s, V d) {
+        return div255(I::mul16(s, d));
+    }
+    static inline V mul(V s, V d) {
+        const V inv = I::sub16(I::set16(255), I::alpha16(s));
+        return I::add16(div255(I::mul16(s, d)), div255(I::mul16(d, inv)));
+    }
+    static inline V screen(V s, V d) {
+        return I::add16(s, div255(I::mul16(d, I::sub16(I::set16(255), s))));
+    }
+
+    template <V (*Op)(V, V), bool KeepDstAlpha, SoftBlend Mode>
+    static void span(uint32_t *dst, const uint32_t *src, int count, uint32_t modulate)
+    {
+        const V zero = I::zero();
+        const V m    = I::unpacklo8(I::set32(modulate), zero);
+        const V amask = I::set32(0xFF000000u);
+
+        int i = 0;
+        for (; i + I::N <= count; i += I::N) {
+            const V sp = I::load(src + i);
+            const V dp = I::load(dst + i);
+            const V slo = div255(I::mul16(I::unpacklo8(sp, zero), m));
+            const V shi = div255(I::mul16(I::unpackhi8(sp, zero), m));
+            const V dlo = I::unpacklo8(dp, zero);
+            const V dhi = I::unpackhi8(dp, zero);
+            V out = I::packus16(Op(slo, dlo), Op(shi, dhi));
+            if (KeepDstAlpha) out = I::or_(I::andnot(amask, out), I::and_(amask, dp));
+            I::store(dst + i, out);
+        }
+        if (i < count)
+            blendKernelsScalar().span[(int)Mode](dst + i, src + i, count - i, modulate);
+    }
+
+    static const BlendKernels& table(const char *name) {
+        static const BlendKernels k = { name, {
+            span<normal, false, SoftBlend::Normal>,
+            span<add,    true,  SoftBlend::Add>,
+            span<mod,    true,  SoftBlend::Mod>,
+            span<mul,    true,  SoftBlend::Mul>,
+            span<screen, false, SoftBlend::Screen>,
+        } };
+        return k;
+    }
+};
+
+} // namespace
@@ -0,0 +1,37 @@
+// Kernels SSE2: 4 pixels por iteração.
+#if defined(ENGINE_HAVE_SSE2)
+#include <emmintrin.h>
+#include "softblend_simd.h"
+
+namespace {
+
+struct Sse2 {
+    using V = __m128i;
+    static constexpr int N = 4;
+
+    static inline V load(const uint32_t *p)  { return _mm_loadu_si128((const __m128i*)p); }
+    static inline void store(uint32_t *p, V v) { _mm_storeu_si128((__m128i*)p, v); }
+    static inline V zero()              { return _mm_setzero_si128(); }
+    static inline V set32(uint32_t v)   { return _mm_set1_epi32((int)v); }
+    static inline V set16(uint16_t v)   { return _mm_set1_epi16((short)v); }
+    static inline V unpacklo8(V a, V b) { return _mm_unpacklo_epi8(a, b); }
+    static inline V unpackhi8(V a, V b) { return _mm_unpackhi_epi8(a, b); }
+    static inline V packus16(V a, V b)  { return _mm_packus_epi16(a, b); }
+    static inline V add16(V a, V b)     { return _mm_add_epi16(a, b); }
+    static inline V sub16(V a, V b)     { return _mm_sub_epi16(a, b); }
+    static inline V mul16(V a, V b)     { return _mm_mullo_epi16(a, b); }
+    static inline V srl8(V a)           { return _mm_srli_epi16(a, 8); }
+    static inline V and_(V a, V b)      { return _mm_and_si128(a, b); }
+    static inline V or_(V a, V b)       { return _mm_or_si128(a, b); }
+    static inline V andnot(V a, V b)    { return _mm_andnot_si128(a, b); }
+    static inline V alpha16(V a) {
+        return _mm_shufflehi_epi16(_mm_shufflelo_epi16(a, _MM_SHUFFLE(3, 3, 3, 3)), _MM_SHUFFLE(3, 3, 3, 3));
+    }
+    static inline V rgbMask16()   { return _mm_set_epi16(0, -1, -1, -1, 0, -1, -1, -1); }
+    static inline V alpha255_16() { return _mm_set_epi16(255, 0, 0, 0, 255, 0, 0, 0); }
+};
+
+} // namespace
+
+const BlendKernels* blendKernelsSSE2() { return &SimdBlend<Sse2>::table("sse2"); }
+#endif
@@ -0,0 +1,591 @@
+#include "softrenderer.h"
+#include <algorithm>
+#include <cmath>
+
+static inline uint32_t packARGB(uint8_t a, uint8_t r, uint8_t g, uint8_t b) {
+    return (uint32_t(a) << 24) | (uint32_t(r) << 16) | (uint32_t(g) << 8) | uint32_t(b);
+}
+
+static inline SoftBlend softBlendFromFx(FxBlend fx) {
+    switch (fx) {
+        case FxBlend::Normal: return SoftBlend::Normal;
+        case FxBlend::Add:    return SoftBlend::Add;
+        case FxBlend::Mod:    return SoftBlend::Mod;
+        case FxBlend::Mul:    return SoftBlend::Mul;
+        case FxBlend::Screen: return SoftBlend::Screen;
+    }
+    return SoftBlend::Normal;
+}
+
+static inline bool intersect(const SDL_Rect &a, const SDL_Rect &b, SDL_Rect &out) {
+    const int x0 = max(a.x, b.x), y0 = max(a.y, b.y);
+    const int x1 = min(a.x + a.w, b.x + b.w), y1 = min(a.y + a.h, b.y + b.h);
+    if (x1 <= x0 || y1 <= y0) return false;
+    out = SDL_Rect{ x0, y0, x1 - x0, y1 - y0 };
+    return true;
+}
+
+static inline const uint32_t* pixelRow(const SDL_Surface *s, int y) {
+    return (const uint32_t*)((const uint8_t*)s->pixels + size_t(y) * s->pitch);
+}
+
+// 0 <= b + a*t < limit  ->  restringe [tmin, tmax)
+static inline void clampRange(float b, float a, float limit, float &tmin, float &tmax) {
+    if (std::fabs(a) < 1e-8f) {
+        if (b < 0.0f || b >= limit) tmax = tmin;
+        return;
+    }
+    float lo = -b / a, hi = (limit - b) / a;
+    if (a < 0.0f) swap(lo, hi);
+    tmin = max(tmin, lo);
+    tmax = min(tmax, hi);
+}
+
+// interpolação bilinear com pesos de 8 bits (0..256)
+static inline uint32_t lerpPixel(uint32_t p0, uint32_t p1, uint32_t f) {
+    const uint32_t rb = (((p0 & 0x00FF00FFu) * (256 - f) + (p1 & 0x00FF00FFu) * f) >> 8) & 0x00FF00FFu;
+    const uint32_t ag = ((((p0 >> 8) & 0x00FF00FFu) * (256 - f) + ((p1 >> 8) & 0x00FF00FFu) * f)) & 0xFF00FF00u;
+    return rb | ag;
+}
+
+bool SoftRenderer::init(SDL_Window *win, int w, int h)
+{
+    release();
+    window = win;
+    width  = w;
+    height = h;
+    frame  = SDL_CreateRGBSurfaceWithFormat(0, w, h, 32, SDL_PIXELFORMAT_ARGB8888);
+    if (!frame) return false;
+    SDL_SetSurfaceBlendMode(frame, SDL_BLENDMODE_NONE);
+    blendKernels();  // escolhe os kernels agora, não no primeiro frame
+    return true;
+}
+
+void SoftRenderer::release()
+{
+    for (auto &item : textLru) SDL_FreeSurface(item.second);
+    textLru.clear();
+    textIndex.clear();
+    for (auto &item : glowLru) SDL_FreeSurface(item.second);
+    glowLru.clear();
+    glowIndex.clear();
+    pool.stop();
+    if (frame) SDL_FreeSurface(frame);
+    frame = nullptr;
+}
+
+SDL_Surface* SoftRenderer::toPixels(SDL_Surface *surface)
+{
+    return surface ? SDL_ConvertSurfaceFormat(surface, SDL_PIXELFORMAT_ARGB8888, 0) : nullptr;
+}
+
+void SoftRenderer::forget(const SDL_Surface *surface)
+{
+    for (auto it = glowLru.begin(); it != glowLru.end();) {
+        if (it->first.surface == surface) {
+            SDL_FreeSurface(it->second);
+            glowIndex.erase(it->first);
+            it = glowLru.erase(it);
+        } else {
+            ++it;
+        }
+    }
+}
+
+void SoftRenderer::render(const DrawList &list, const vector<GameResource> &textures, const FontLookup &fonts)
+{
+    if (!frame) return;
+    const Uint64 t0 = SDL_GetPerformanceCounter();
+
+    ops.clear();
+    pending.clear();
+    points.clear();
+    stats = SoftStats{};
+
+    for (const DrawCmd &c : list.cmds) {
+        switch (c.type) {
+            case DrawCmd::IMAGE:
+                if (c.image.valid() && c.image.index < (int32_t)textures.size() &&
+                    textures[c.image.index].surface)
+                    addImage(c, pickMipLevel(textures, c.image.index, abs(c.w), abs(c.h)));
+                break;
+            case DrawCmd::SPRITES: {
+                DrawCmd one = c;
+                one.type = DrawCmd::IMAGE;
+                const DrawSprite *sp = list.sprites.data() + c.first;
+                for (uint32_t i = 0; i < c.count; ++i, ++sp) {
+                    if (!sp->image.valid() || sp->image.index >= (int32_t)textures.size() ||
+                        !textures[sp->image.index].surface) continue;
+                    one.image = sp->image;
+                    one.x = sp->x; one.y = sp->y; one.w = sp->w; one.h = sp->h;
+                    one.angle = sp->angle;
+                    one.fx.tint_r = sp->tint.r;
+                    one.fx.tint_g = sp->tint.g;
+                    one.fx.tint_b = sp->tint.b;
+                    one.fx.alpha  = sp->tint.a;
+                    addImage(one, pickMipLevel(textures, sp->image.index, abs(sp->w), abs(sp->h)));
+                }
+                break;
+            }
+            case DrawCmd::TEXT:
+                flushPending();
+                addText(c, list, fonts);
+                break;
+            case DrawCmd::RECT: {
+                flushPending();
+                const uint32_t color = packARGB(c.color.a, c.color.r, c.color.g, c.color.b);
+                if (c.flag) {
+                    addFill(c.x, c.y, c.w, c.h, color);
+                } else if (c.w > 0 && c.h > 0) {
+                    // mesmos pixels do SDL_RenderDrawRect
+                    addFill(c.x, c.y, c.w, 1, color);
+                    if (c.h > 1) addFill(c.x, c.y + c.h - 1, c.w, 1, color);
+                    addFill(c.x, c.y + 1, 1, c.h - 2, color);
+                    if (c.w > 1) addFill(c.x + c.w - 1, c.y + 1, 1, c.h - 2, color);
+                }
+                break;
+            }
+            case DrawCmd::LINE:
+                flushPending();
+                addLine(c.x, c.y, c.x2, c.y2, packARGB(c.color.a, c.color.r, c.color.g, c.color.b));
+                break;
+            case DrawCmd::CIRCLE: {
+                flushPending();
+                const uint32_t color = packARGB(c.color.a, c.color.r, c.color.g, c.color.b);
+                const int radius = c.size;
+                if (c.flag) {
+                    for (int dy = -radius; dy <= radius; dy++) {
+                        const int dx = (int)std::sqrt(float(radius * radius - dy * dy));
+                        addFill(c.x - dx, c.y + dy, 2 * dx + 1, 1, color);
+                    }
+                    break;
+                }
+                Op op;
+                op.kind  = Op::POINTS;
+                op.color = color;
+                op.first = (uint32_t)points.size();
+                int x = radius, y = 0, err = 0;
+                while (x >= y) {
+                    points.insert(points.end(), {
+                        SDL_Point{ c.x + x, c.y + y }, SDL_Point{ c.x + y, c.y + x },
+                        SDL_Point{ c.x - y, c.y + x }, SDL_Point{ c.x - x, c.y + y },
+                        SDL_Point{ c.x - x, c.y - y }, SDL_Point{ c.x - y, c.y - x },
+                        SDL_Point{ c.x + y, c.y - x }, SDL_Point{ c.x + x, c.y - y } });
+                    if (err <= 0) { y += 1; err += 2*y + 1; }
+                    if (err > 0)  { x -= 1; err -= 2*x + 1; }
+                }
+                op.count  = (uint32_t)points.size() - op.first;
+                op.bounds = SDL_Rect{ c.x - radius, c.y - radius, 2 * radius + 1, 2 * radius + 1 };
+                if (intersect(op.bounds, SDL_Rect{ 0, 0, width, height }, op.bounds)) ops.push_back(op);
+                break;
+            }
+            case DrawCmd::POINT:
+                flushPending();
+                addFill(c.x, c.y, 1, 1, packARGB(c.color.a, c.color.r, c.color.g, c.color.b));
+                break;
+            case DrawCmd::POLYGON: {
+                flushPending();
+                const uint32_t color = packARGB(c.color.a, c.color.r, c.color.g, c.color.b);
+                const pair<int,int> *p = list.points.data() + c.first;
+                for (uint32_t i = 0; i + 1 < c.count; ++i)
+                    addLine(p[i].first, p[i].second, p[i + 1].first, p[i + 1].second, color);
+                if (c.flag && c.count > 1)
+                    addLine(p[c.count - 1].first, p[c.count - 1].second, p[0].first, p[0].second, color);
+                break;
+            }
+            case DrawCmd::LAYER_BEGIN:
+            case DrawCmd::LAYER_END:
+                break;   // sem camadas em cache aqui: os membros vêm gravados como comandos normais
+        }
+    }
+    flushPending();
+
+    const int threads = threadCount > 0 ? threadCount : max(1, SDL_GetCPUCount());
+    if (pool.size() != threads) pool.start(threads);
+    if ((int)spans.size() < threads) spans.resize(threads);
+    binOps();
+
+    SDL_LockSurface(frame);
+    pool.run((int)tiles.size(), [this](int index, int worker) { rasterTile(index, worker); });
+    SDL_UnlockSurface(frame);
+    trimCaches();
+
+    for (const SoftTile &tile : tiles) stats.pixels += tile.pixels;
+    stats.tiles   = (int)tiles.size();
+    stats.threads = threads;
+    stats.ops = (int)ops.size();
+    stats.rasterMs = double(SDL_GetPerformanceCounter() - t0) * 1000.0 / double(SDL_GetPerformanceFrequency());
+}
+
+void SoftRenderer::present()
+{
+    if (!frame || !window) return;
+    SDL_Surface *target = SDL_GetWindowSurface(window);
+    if (!target) return;
+    SDL_BlitSurface(frame, nullptr, target, nullptr);
+    SDL_UpdateWindowSurface(window);
+}
+
+void SoftRenderer::addImage(const DrawCmd &c, const MipLevel &level)
+{
+    const FxParams &fx = c.fx;
+
+    Op op;
+    op.kind    = Op::BLIT;
+    op.src     = level.surface;
+    op.srcRect = level.src;
+    op.angle   = c.angle;
+    op.depth   = c.depth;
+
+    if (fx.glowRadius > 0) {
+        const int R = fx.glowRadius;
+        const Uint32 rgb = (Uint32(fx.glow_r) << 16) | (Uint32(fx.glow_g) << 8) | fx.glow_b;
+        if (SDL_Surface *halo = glowSurface(SoftGlowKey{ level.surface, level.src, c.w, c.h, R, rgb })) {
+            Op glow = op;
+            glow.src     = halo;
+            glow.srcRect = SDL_Rect{ 0, 0, halo->w, halo->h };
+            glow.dst     = SDL_FRect{ float(c.x - R), float(c.y - R), float(halo->w), float(halo->h) };
+            glow.blend   = SoftBlend::Add;
+            glow.color   = packARGB(fx.glow_a, 255, 255, 255);
+            glow.layer   = 0;
+            pending.push_back(glow);
+        }
+    }
+
+    op.layer = 1;
+    op.blend = softBlendFromFx(fx.blend);
+    op.color = packARGB(fx.alpha, fx.tint_r, fx.tint_g, fx.tint_b);
+    op.dst   = SDL_FRect{ float(c.x), float(c.y), float(c.w), float(c.h) };
+    pending.push_back(op);
+}
+
+void SoftRenderer::addText(const DrawCmd &c, const DrawList &list, const FontLookup &fonts)
+{
+    const string &text     = list.getString(c.str);
+    const string &fontName = list.getString(c.font);
+    TTF_Font *font = fonts ? fonts(fontName, c.size) : nullptr;
+    if (!font || text.empty()) return;
+
+    const SDL_Color color{ c.color.r, c.color.g, c.color.b, c.color.a };
+    SDL_Surface *surf = textSurface(font, fontName, c.size, color, text);
+    if (!surf) return;
+
+    Op op;
+    op.kind    = Op::BLIT;
+    op.src     = surf;
+    op.srcRect = SDL_Rect{ 0, 0, surf->w, surf->h };
+    int x = c.x, y = c.y;
+    if (c.flag) {
+        x -= surf->w / 2;
+        y -= surf->h / 2;
+    }
+    op.dst   = SDL_FRect{ float(x), float(y), float(surf->w), float(surf->h) };
+    op.depth = c.depth;
+    op.bounds = SDL_Rect{ x, y, surf->w, surf->h };
+    if (intersect(op.bounds, SDL_Rect{ 0, 0, width, height }, op.bounds)) ops.push_back(op);
+}
+
+void SoftRenderer::addFill(int x, int y, int w, int h, uint32_t color)
+{
+    Op op;
+    op.kind  = Op::FILL;
+    op.color = color;
+    if (intersect(SDL_Rect{ x, y, w, h }, SDL_Rect{ 0, 0, width, height }, op.bounds)) ops.push_back(op);
+}
+
+void SoftRenderer::addLine(int x0, int y0, int x1, int y1, uint32_t color)
+{
+    if (y0 == y1) { addFill(min(x0, x1), y0, abs(x1 - x0) + 1, 1, color); return; }
+    if (x0 == x1) { addFill(x0, min(y0, y1), 1, abs(y1 - y0) + 1, color); return; }
+
+    Op op;
+    op.kind  = Op::LINE;
+    op.color = color;
+    op.x0 = x0; op.y0 = y0; op.x1 = x1; op.y1 = y1;
+    const SDL_Rect box{ min(x0, x1), min(y0, y1), abs(x1 - x0) + 1, abs(y1 - y0) + 1 };
+    if (intersect(box, SDL_Rect{ 0, 0, width, height }, op.bounds)) ops.push_back(op);
+}
+
+// Sprites ficam juntos até o próximo texto/primitiva e saem em depth -> camada,
+// a mesma ordem que o SpriteBatch usa no renderer acelerado
+void SoftRenderer::flushPending()
+{
+    if (pending.empty()) return;
+    stable_sort(pending.begin(), pending.end(), [](const Op &a, const Op &b) {
+        if (a.depth != b.depth) return a.depth > b.depth;
+        return a.layer < b.layer;
+    });
+
+    const SDL_Rect screen{ 0, 0, width, height };
+    for (Op &op : pending) {
+        const float hw = op.dst.w * 0.5f, hh = op.dst.h * 0.5f;
+        const float cx = op.dst.x + hw, cy = op.dst.y + hh;
+        float ex = hw, ey = hh;
+        if (op.angle != 0.0f) {
+            const float rad = op.angle * float(M_PI / 180.0);
+            const float cs = std::fabs(std::cos(rad)), sn = std::fabs(std::sin(rad));
+            ex = hw * cs + hh * sn;
+            ey = hw * sn + hh * cs;
+        }
+        const int x0 = (int)std::floor(cx - ex), y0 = (int)std::floor(cy - ey);
+        const int x1 = (int)std::ceil(cx + ex),  y1 = (int)std::ceil(cy + ey);
+        if (intersect(SDL_Rect{ x0, y0, x1 - x0, y1 - y0 }, screen, op.bounds)) ops.push_back(op);
+    }
+    pending.clear();
+}
+
+SDL_Surface* SoftRenderer::textSurface(TTF_Font *font, const string &fontName, int size, SDL_Color color,
+                                       const string &text)
+{
+    TextKey key{ fontName, size,
+                 (Uint32(color.r) << 24) | (Uint32(color.g) << 16) | (Uint32(color.b) << 8) | Uint32(color.a),
+                 text };
+    auto it = textIndex.find(key);
+    if (it != textIndex.end()) {
+        if (it->second != textLru.begin()) textLru.splice(textLru.begin(), textLru, it->second);
+        return it->second->second;
+    }
+
+    SDL_Surface *raw = TTF_RenderUTF8_Blended(font, text.c_str(), color);
+    if (!raw) return nullptr;
+    SDL_Surface *surf = toPixels(raw);
+    SDL_FreeSurface(raw);
+    if (!surf) return nullptr;
+
+    textLru.emplace_front(move(key), surf);
+    textIndex[textLru.front().first] = textLru.begin();
+    return surf;
+}
+
+// Mesma conta do halo assado no GPU: cada anel soma a imagem tingida com
+// alpha * falloff; o alpha do halo fica 255 e ele é desenhado com Add.
+SDL_Surface* SoftRenderer::glowSurface(const SoftGlowKey &key)
+{
+    if (key.radius <= 0 || key.w <= 0 || key.h <= 0 || !key.surface) return nullptr;
+
+    auto it = glowIndex.find(key);
+    if (it != glowIndex.end()) {
+        if (it->second != glowLru.begin()) glowLru.splice(glowLru.begin(), glowLru, it->second);
+        return it->second->second;
+    }
+
+    const int R = key.radius, w = key.w, h = key.h;
+    const int hw = w + 2 * R, hh = h + 2 * R;
+    const uint32_t gr = (key.rgb >> 16) & 0xFF, gg = (key.rgb >> 8) & 0xFF, gb = key.rgb & 0xFF;
+
+    // imagem no tamanho da tela, já tingida com a cor do glow
+    vector<uint32_t> tinted(size_t(w) * h);
+    for (int j = 0; j < h; ++j) {
+        const uint32_t *row = pixelRow(key.surface, key.src.y + j * key.src.h / h);
+        for (int i = 0; i < w; ++i) {
+            const uint32_t p = row[key.src.x + i * key.src.w / w];
+            tinted[size_t(j) * w + i] = packARGB(p >> 24,
+                                                 softDiv255(((p >> 16) & 0xFF) * gr),
+                                                 softDiv255(((p >> 8) & 0xFF) * gg),
+                                                 softDiv255((p & 0xFF) * gb));
+        }
+    }
+
+    vector<uint32_t> acc(size_t(hw) * hh * 3, 0);
+    for (int r = 1; r <= R; ++r) {
+        const uint32_t fa = (uint32_t)std::lround(255.0f * (1.0f - (float)r / (R + 1)));
+        const int offsets[8][2] = { {-r,0},{r,0},{0,-r},{0,r},{-r,-r},{-r,r},{r,-r},{r,r} };
+        for (auto &o : offsets) {
+            for (int j = 0; j < h; ++j) {
+                uint32_t *dst = &acc[(size_t(R + o[1] + j) * hw + R + o[0]) * 3];
+                const uint32_t *src = &tinted[size_t(j) * w];
+                for (int i = 0; i < w; ++i, dst += 3) {
+                    const uint32_t p = src[i];
+                    const uint32_t a = softDiv255((p >> 24) * fa);
+                    if (!a) continue;
+                    dst[0] += softDiv255(((p >> 16) & 0xFF) * a);
+                    dst[1] += softDiv255(((p >> 8) & 0xFF) * a);
+                    dst[2] += softDiv255((p & 0xFF) * a);
+                }
+            }
+        }
+    }
+
+    SDL_Surface *halo = SDL_CreateRGBSurfaceWithFormat(0, hw, hh, 32, SDL_PIXELFORMAT_ARGB8888);
+    if (!halo) return nullptr;
+    for (int j = 0; j < hh; ++j) {
+        uint32_t *row = (uint32_t*)((uint8_t*)halo->pixels + size_t(j) * halo->pitch);
+        const uint32_t *a = &acc[size_t(j) * hw * 3];
+        for (int i = 0; i < hw; ++i, a += 3)
+            row[i] = packARGB(255, (uint8_t)min<uint32_t>(a[0], 255), (uint8_t)min<uint32_t>(a[1], 255),
+                              (uint8_t)min<uint32_t>(a[2], 255));
+    }
+
+    glowLru.emplace_front(key, halo);
+    glowIndex[key] = glowLru.begin();
+    return halo;
+}
+
+void SoftRenderer::trimCaches()
+{
+    while (textIndex.size() > textCapacity) {
+        SDL_FreeSurface(textLru.back().second);
+        textIndex.erase(textLru.back().first);
+        textLru.pop_back();
+    }
+    while (glowIndex.size() > glowCapacity) {
+        SDL_FreeSurface(glowLru.back().second);
+        glowIndex.erase(glowLru.back().first);
+        glowLru.pop_back();
+    }
+}
+
+// Cada op entra em todos os tiles que a caixa dela toca; como as ops são
+// percorridas em ordem, cada tile mantém a ordem de desenho do frame.
+void SoftRenderer::binOps()
+{
+    const int tilesX = (width + tileSize - 1) / tileSize;
+    const int tilesY = (height + tileSize - 1) / tileSize;
+    const size_t n = size_t(tilesX) * tilesY;
+    if (tiles.size() != n) {
+        tiles.resize(n);
+        bins.resize(n);
+    }
+    for (int ty = 0; ty < tilesY; ++ty)
+        for (int tx = 0; tx < tilesX; ++tx) {
+            const int x = tx * tileSize, y = ty * tileSize;
+            tiles[size_t(ty) * tilesX + tx].rect = SDL_Rect{ x, y, min(tileSize, width - x), min(tileSize, height - y) };
+        }
+    for (auto &bin : bins) bin.clear();
+
+    for (uint32_t i = 0; i < (uint32_t)ops.size(); ++i) {
+        const SDL_Rect &b = ops[i].bounds;
+        const int tx0 = b.x / tileSize, tx1 = (b.x + b.w - 1) / tileSize;
+        const int ty0 = b.y / tileSize, ty1 = (b.y + b.h - 1) / tileSize;
+        for (int ty = ty0; ty <= ty1; ++ty)
+            for (int tx = tx0; tx <= tx1; ++tx) bins[size_t(ty) * tilesX + tx].push_back(i);
+    }
+}
+
+void SoftRenderer::rasterTile(int index, int worker)
+{
+    const Uint64 t0 = SDL_GetPerformanceCounter();
+    SoftTile &tile = tiles[index];
+    const SDL_Rect &r = tile.rect;
+
+    for (int y = r.y; y < r.y + r.h; ++y) {
+        uint32_t *row = (uint32_t*)((uint8_t*)frame->pixels + size_t(y) * frame->pitch) + r.x;
+        std::fill(row, row + r.w, 0xFF000000u);
+    }
+
+    uint64_t pixels = 0;
+    for (uint32_t i : bins[index]) pixels += execute(ops[i], r, spans[worker]);
+
+    tile.ops    = (int)bins[index].size();
+    tile.pixels = pixels;
+    tile.ms     = double(SDL_GetPerformanceCounter() - t0) * 1000.0 / double(SDL_GetPerformanceFrequency());
+}
+
+uint64_t SoftRenderer::execute(const Op &op, const SDL_Rect &clip, vector<uint32_t> &span)
+{
+    SDL_Rect r;
+    if (!intersect(op.bounds, clip, r)) return 0;
+
+    auto row = [this](int y) { return (uint32_t*)((uint8_t*)frame->pixels + size_t(y) * frame->pitch); };
+
+    switch (op.kind) {
+        case Op::BLIT:
+            return blit(op, r, span);
+
+        case Op::FILL:
+            // primitivas substituem o pixel (blend NONE, o padrão do renderer)
+            for (int y = r.y; y < r.y + r.h; ++y) {
+                uint32_t *p = row(y) + r.x;
+                std::fill(p, p + r.w, op.color);
+            }
+            return 0;
+
+        case Op::LINE: {
+            int x = op.x0, y = op.y0;
+            const int dx = abs(op.x1 - op.x0), dy = -abs(op.y1 - op.y0);
+            const int stepx = op.x0 < op.x1 ? 1 : -1, stepy = op.y0 < op.y1 ? 1 : -1;
+            int err = dx + dy;
+            while (true) {
+                if (x >= r.x && x < r.x + r.w && y >= r.y && y < r.y + r.h) row(y)[x] = op.color;
+                if (x == op.x1 && y == op.y1) break;
+                const int e2 = 2 * err;
+                if (e2 >= dy) { err += dy; x += stepx; }
+                if (e2 <= dx) { err += dx; y += stepy; }
+            }
+            return 0;
+        }
+
+        case Op::POINTS:
+            for (uint32_t i = op.first; i < op.first + op.count; ++i) {
+                const SDL_Point &p = points[i];
+                if (p.x >= r.x && p.x < r.x + r.w && p.y >= r.y && p.y < r.y + r.h) row(p.y)[p.x] = op.color;
+            }
+            return 0;
+    }
+    return 0;
+}
+
+// Blit escalado/girado: para cada linha da caixa afetada, acha o trecho que cai
+// dentro da imagem (mapeamento inverso), amostra num span e passa pelo kernel.
+uint64_t SoftRenderer::blit(const Op &op, const SDL_Rect &r, vector<uint32_t> &span)
+{
+    if (op.dst.w <= 0.0f || op.dst.h <= 0.0f || op.srcRect.w <= 0 || op.srcRect.h <= 0) return 0;
+
+    const float hw = op.dst.w * 0.5f, hh = op.dst.h * 0.5f;
+    const float cx = op.dst.x + hw,   cy = op.dst.y + hh;
+    const float sx = op.srcRect.w / op.dst.w, sy = op.srcRect.h / op.dst.h;
+    float cs = 1.0f, sn = 0.0f;
+    if (op.angle != 0.0f) {
+        const float rad = op.angle * float(M_PI / 180.0);
+        cs = std::cos(rad);
+        sn = std::sin(rad);
+    }
+    // derivadas de (u, v) ao andar um pixel em x
+    const float du = cs * sx, dv = -sn * sy;
+    const int srcW = op.srcRect.w, srcH = op.srcRect.h;
+    const bool bilinear = filter == SoftFilter::Bilinear;
+
+    if ((int)span.size() < r.w) span.resize(r.w);
+    const BlendSpanFn fn = blendKernels().span[(int)op.blend];
+    uint64_t pixels = 0;
+
+    for (int y = r.y; y < r.y + r.h; ++y) {
+        const float ly = y + 0.5f - cy;
+        const float lx = r.x + 0.5f - cx;
+        const float u0 = ( lx * cs + ly * sn + hw) * sx;
+        const float v0 = (-lx * sn + ly * cs + hh) * sy;
+
+        float tmin = 0.0f, tmax = float(r.w);
+        clampRange(u0, du, float(srcW), tmin, tmax);
+        clampRange(v0, dv, float(srcH), tmin, tmax);
+        const int t0 = max(0, (int)std::ceil(tmin));
+        const int t1 = min(r.w, (int)std::ceil(tmax));
+        if (t1 <= t0) continue;
+
+        uint32_t *out = span.data();
+        if (!bilinear) {
+            for (int t = t0; t < t1; ++t) {
+                const int u = min(srcW - 1, max(0, (int)(u0 + t * du)));
+                const int v = min(srcH - 1, max(0, (int)(v0 + t * dv)));
+                *out++ = pixelRow(op.src, op.srcRect.y + v)[op.srcRect.x + u];
+            }
+        } else {
+            for (int t = t0; t < t1; ++t) {
+                const float fu = u0 + t * du - 0.5f, fv = v0 + t * dv - 0.5f;
+                const int iu = (int)std::floor(fu), iv = (int)std::floor(fv);
+                const uint32_t wu = (uint32_t)((fu - iu) * 256.0f), wv = (uint32_t)((fv - iv) * 256.0f);
+                const int ua = op.srcRect.x + min(srcW - 1, max(0, iu));
+                const int ub = op.srcRect.x + min(srcW - 1, max(0, iu + 1));
+                const uint32_t *ra = pixelRow(op.src, op.srcRect.y + min(srcH - 1, max(0, iv)));
+                const uint32_t *rb = pixelRow(op.src, op.srcRect.y + min(srcH - 1, max(0, iv + 1)));
+                *out++ = lerpPixel(lerpPixel(ra[ua], ra[ub], wu), lerpPixel(rb[ua], rb[ub], wu), wv);
+            }
+        }
+
+        const int n = t1 - t0;
+        uint32_t *dst = (uint32_t*)((uint8_t*)frame->pixels + size_t(y) * frame->pitch) + r.x + t0;
+        fn(dst, span.data(), n, op.color);
+        pixels += n;
+    }
+    return pixels;
+}
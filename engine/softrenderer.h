@@ -0,0 +1,166 @@
+#pragma once
+#include <SDL2/SDL.h>
+#include <SDL2/SDL_ttf.h>
+#include <vector>
+#include <list>
+#include <string>
+#include <functional>
+#include <algorithm>
+#include <unordered_map>
+#include <cstdint>
+#include "softblend.h"
+#include "drawlist.h"
+#include "resources.h"
+#include "textcache.h"
+#include "threadpool.h"
+
+using namespace std;
+
+enum class SoftFilter : uint8_t { Nearest, Bilinear };
+
+// Halo de glow assado na CPU: mesma conta do GlowCache (anéis com falloff linear)
+struct SoftGlowKey {
+    const SDL_Surface *surface;
+    SDL_Rect src;
+    int      w, h;
+    int      radius;
+    Uint32   rgb;
+    bool operator==(const SoftGlowKey &o) const {
+        return surface == o.surface && src.x == o.src.x && src.y == o.src.y &&
+               src.w == o.src.w && src.h == o.src.h && w == o.w && h == o.h &&
+               radius == o.radius && rgb == o.rgb;
+    }
+};
+struct SoftGlowKeyHash {
+    size_t operator()(const SoftGlowKey &k) const {
+        size_t h = hash<const void*>()(k.surface);
+        auto mix = [&h](uint64_t v) { h ^= hash<uint64_t>()(v) + 0x9e3779b9 + (h << 6) + (h >> 2); };
+        mix((uint64_t(uint32_t(k.src.x)) << 32) | uint32_t(k.src.y));
+        mix((uint64_t(uint32_t(k.src.w)) << 32) | uint32_t(k.src.h));
+        mix((uint64_t(uint32_t(k.w)) << 32) | uint32_t(k.h));
+        mix((uint64_t(uint32_t(k.radius)) << 32) | k.rgb);
+        return h;
+    }
+};
+
+// Contadores do último frame rasterizado
+struct SoftStats {
+    int      ops = 0;          // blits/preenchimentos executados
+    uint64_t pixels = 0;       // pixels que passaram pelos kernels de blend
+    double   rasterMs = 0.0;   // tempo da rasterização (sem o present)
+    int      tiles = 0;
+    int      threads = 1;
+};
+
+// Um tile da tela no último frame
+struct SoftTile {
+    SDL_Rect rect{0, 0, 0, 0};
+    int      ops = 0;          // operações que tocaram o tile
+    uint64_t pixels = 0;
+    double   ms = 0.0;         // tempo da thread que rasterizou o tile
+};
+
+// Backend de renderização na CPU: consome o DrawList do frame e rasteriza num
+// framebuffer ARGB8888, que é copiado pra superfície da janela no present.
+// Imagens vêm do GameResource::surface (cópia ARGB8888 feita no loadImage),
+// no nível de mip mais perto do tamanho na tela.
+// Texto e halos de glow ficam em caches LRU de superfícies.
+// As operações do frame são distribuídas em tiles da tela (cada tile guarda os
+// índices na ordem de desenho) e os tiles são rasterizados em paralelo.
+class SoftRenderer {
+public:
+    using FontLookup = function<TTF_Font*(const string&, int)>;
+
+    SoftRenderer() = default;
+    ~SoftRenderer() { release(); }
+
+    SoftRenderer(const SoftRenderer&) = delete;
+    SoftRenderer& operator=(const SoftRenderer&) = delete;
+
+    bool init(SDL_Window *window, int w, int h);
+    void release();
+
+    void setFilter(SoftFilter f) { filter = f; }
+    SoftFilter getFilter() const { return filter; }
+    const char* getKernelName() const { return blendKernels().name; }
+
+    void setTileSize(int size) { tileSize = max(16, size); }
+    int  getTileSize() const   { return tileSize; }
+    // 0 = uma thread por núcleo (SDL_GetCPUCount)
+    void setThreads(int n)     { threadCount = max(0, n); }
+    int  getThreads() const    { return threadCount; }
+
+    // Superfície no formato que o rasterizador lê (nova; quem chama libera)
+    static SDL_Surface* toPixels(SDL_Surface *surface);
+
+    // a superfície de uma imagem vai ser liberada: descarta os halos dela
+    void forget(const SDL_Surface *surface);
+
+    void render(const DrawList &list, const vector<GameResource> &textures, const FontLookup &fonts);
+    void present();
+
+    const SoftStats& getStats() const { return stats; }
+    const vector<SoftTile>& getTiles() const { return tiles; }
+
+private:
+    // Operação já resolvida (imagem, retângulos, cor), pronta pra rasterizar
+    struct Op {
+        enum Kind : uint8_t { BLIT, FILL, LINE, POINTS };
+        Kind      kind  = BLIT;
+        SoftBlend blend = SoftBlend::Normal;
+        int       depth = 0;
+        int       layer = 1;                 // como no SpriteBatch: 0 = glow, 1 = sprite
+        const SDL_Surface *src = nullptr;
+        SDL_Rect  srcRect{0, 0, 0, 0};
+        SDL_FRect dst{0, 0, 0, 0};           // BLIT: retângulo antes da rotação
+        float     angle = 0.0f;              // graus, horário, em torno do centro de dst
+        uint32_t  color = 0xFFFFFFFFu;       // BLIT: modulate; demais: cor ARGB
+        SDL_Rect  bounds{0, 0, 0, 0};        // caixa afetada na tela
+        int       x0 = 0, y0 = 0, x1 = 0, y1 = 0;   // LINE
+        uint32_t  first = 0, count = 0;      // POINTS: faixa em points
+    };
+
+    SDL_Window  *window = nullptr;
+    SDL_Surface *frame  = nullptr;
+    int width = 0, height = 0;
+    SoftFilter filter = SoftFilter::Nearest;
+
+    vector<Op>        ops;
+    vector<Op>        pending;     // sprites até o próximo texto/primitiva (ordenados por depth/camada)
+    vector<SDL_Point> points;
+    SoftStats stats;
+
+    int tileSize = 64;
+    int threadCount = 0;
+    ThreadPool pool;
+    vector<SoftTile> tiles;
+    vector<vector<uint32_t>> bins;     // por tile: índices em ops, na ordem de desenho
+    vector<vector<uint32_t>> spans;    // por worker: span de origem já amostrado
+
+    // caches
+    using TextItem = pair<TextKey, SDL_Surface*>;
+    list<TextItem> textLru;
+    unordered_map<TextKey, list<TextItem>::iterator, TextKeyHash> textIndex;
+    size_t textCapacity = 128;
+
+    using GlowItem = pair<SoftGlowKey, SDL_Surface*>;
+    list<GlowItem> glowLru;
+    unordered_map<SoftGlowKey, list<GlowItem>::iterator, SoftGlowKeyHash> glowIndex;
+    size_t glowCapacity = 64;
+
+    void addImage(const DrawCmd &c, const MipLevel &level);
+    void addText(const DrawCmd &c, const DrawList &list, const FontLookup &fonts);
+    void addFill(int x, int y, int w, int h, uint32_t color);
+    void addLine(int x0, int y0, int x1, int y1, uint32_t color);
+    void flushPending();
+    void binOps();
+    void rasterTile(int index, int worker);
+    void trimCaches();     // só depois de rasterizar: as ops apontam pras superfícies
+
+    SDL_Surface* textSurface(TTF_Font *font, const string &fontName, int size, SDL_Color color, const string &text);
+    SDL_Surface* glowSurface(const SoftGlowKey &key);
+
+    // devolvem quantos pixels passaram pelos kernels de blend
+    uint64_t execute(const Op &op, const SDL_Rect &clip, vector<uint32_t> &span);
+    uint64_t blit(const Op &op, const SDL_Rect &clip, vector<uint32_t> &span);
+};
@@ -0,0 +1,90 @@
+#include "spritebatch.h"
+#include <algorithm>
+#include <cmath>
+
+static inline Uint32 packColor(SDL_Color c) {
+    return (Uint32(c.r) << 24) | (Uint32(c.g) << 16) | (Uint32(c.b) << 8) | Uint32(c.a);
+}
+
+static bool spriteOrder(const SpriteCmd &a, const SpriteCmd &b)
+{
+    if (a.depth != b.depth)     return a.depth > b.depth;
+    if (a.layer != b.layer)     return a.layer < b.layer;
+    if (a.texture != b.texture) return a.texture < b.texture;
+    if (a.blend != b.blend)     return a.blend < b.blend;
+    return packColor(a.color) < packColor(b.color);
+}
+
+int SpriteBatch::flush()
+{
+    if (cmds.empty() || !renderer || !state) {
+        cmds.clear();
+        return 0;
+    }
+
+    stable_sort(cmds.begin(), cmds.end(), spriteOrder);
+
+    const int before = drawCalls;
+    verts.clear();
+    indices.clear();
+
+    SDL_Texture  *runTex   = cmds.front().texture;
+    SDL_BlendMode runBlend = cmds.front().blend;
+    int texW = 1, texH = 1;
+    SDL_QueryTexture(runTex, nullptr, nullptr, &texW, &texH);
+
+    for (const SpriteCmd &c : cmds) {
+        if (c.texture != runTex || c.blend != runBlend) {
+            submit(runTex, runBlend);
+            runTex   = c.texture;
+            runBlend = c.blend;
+            SDL_QueryTexture(runTex, nullptr, nullptr, &texW, &texH);
+        }
+
+        const float u0 = float(c.src.x) / texW;
+        const float v0 = float(c.src.y) / texH;
+        const float u1 = float(c.src.x + c.src.w) / texW;
+        const float v1 = float(c.src.y + c.src.h) / texH;
+
+        // cantos relativos ao centro
+        const float hw = c.dst.w * 0.5f;
+        const float hh = c.dst.h * 0.5f;
+        const float cx = c.dst.x + hw;
+        const float cy = c.dst.y + hh;
+        float px[4] = { -hw,  hw, hw, -hw };
+        float py[4] = { -hh, -hh, hh,  hh };
+
+        if (c.angle != 0.0f) {
+            const float rad = c.angle * float(M_PI / 180.0);
+            const float cs = cosf(rad), sn = sinf(rad);
+            for (int k = 0; k < 4; ++k) {
+                const float rx = px[k] * cs - py[k] * sn;
+                const float ry = px[k] * sn + py[k] * cs;
+                px[k] = rx;
+                py[k] = ry;
+            }
+        }
+
+        const int base = (int)verts.size();
+        verts.push_back({ { cx + px[0], cy + py[0] }, c.color, { u0, v0 } });
+        verts.push_back({ { cx + px[1], cy + py[1] }, c.color, { u1, v0 } });
+        verts.push_back({ { cx + px[2], cy + py[2] }, c.color, { u1, v1 } });
+        verts.push_back({ { cx + px[3], cy + py[3] }, c.color, { u0, v1 } });
+        indices.insert(indices.end(), { base, base + 1, base + 2, base, base + 2, base + 3 });
+        ++sprites;
+    }
+    submit(runTex, runBlend);
+
+    cmds.clear();
+    return drawCalls - before;
+}
+
+void SpriteBatch::submit(SDL_Texture *tex, SDL_BlendMode blend)
+{
+    if (indices.empty()) return;
+    state->textureBlend(tex, blend);
+    SDL_RenderGeometry(renderer, tex, verts.data(), (int)verts.size(), indices.data(), (int)indices.size());
+    ++drawCalls;
+    verts.clear();
+    indices.clear();
+}
@@ -0,0 +1,49 @@
+#pragma once
+#include <SDL2/SDL.h>
+#include <vector>
+#include "renderstate.h"
+
+using namespace std;
+
+// Um sprite enfileirado pra desenhar
+struct SpriteCmd {
+    SDL_Texture  *texture = nullptr;
+    SDL_Rect      src{0, 0, 0, 0};
+    SDL_FRect     dst{0, 0, 0, 0};
+    float         angle = 0.0f;                  // graus, horário, em torno do centro de dst
+    SDL_Color     color{255, 255, 255, 255};     // tint + alpha (vai no vértice)
+    SDL_BlendMode blend = SDL_BLENDMODE_BLEND;
+    int           depth = 0;                     // maior desenha primeiro
+    int           layer = 1;                     // dentro do depth: -1 = camada estática, 0 = glow, 1 = sprite
+};
+
+// Junta os sprites do frame, ordena por depth -> camada -> textura -> blend -> cor
+// e manda cada sequência com mesma textura/blend num único SDL_RenderGeometry.
+// A rotação é feita na CPU (cantos do quad), a cor e o alpha vão nos vértices.
+class SpriteBatch {
+public:
+    void setRenderer(SDL_Renderer *r, RenderState *s) { renderer = r; state = s; }
+
+    void add(const SpriteCmd &c) { cmds.push_back(c); }
+    bool empty() const { return cmds.empty(); }
+
+    // Desenha tudo que está na fila. Retorna quantas chamadas de desenho foram feitas.
+    int flush();
+
+    // --- estatísticas (acumulam até resetStats) ---
+    int  getDrawCalls() const { return drawCalls; }
+    int  getSprites() const   { return sprites; }
+    void resetStats()         { drawCalls = sprites = 0; }
+
+private:
+    SDL_Renderer     *renderer = nullptr;
+    RenderState      *state    = nullptr;
+    vector<SpriteCmd>  cmds;
+    vector<SDL_Vertex> verts;
+    vector<int>        indices;
+
+    int drawCalls = 0;
+    int sprites   = 0;
+
+    void submit(SDL_Texture *tex, SDL_BlendMode blend);
+};
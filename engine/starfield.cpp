@@ -0,0 +1,62 @@
+#include "starfield.h"
+#if defined(ENGINE_HAVE_SSE2)
+#include <emmintrin.h>
+#endif
+
+int Starfield::addBand(int count, float speed, TextureId image, int w, int h, Color tint)
+{
+    StarBand band;
+    band.image = image;
+    band.speed = speed;
+    band.w     = w > 0 ? w : 1;
+    band.h     = h > 0 ? h : 1;
+    band.tint  = tint;
+    band.x.resize(count);
+    band.y.resize(count);
+
+    uniform_real_distribution<float> rx(0.0f, float(width)), ry(0.0f, float(height));
+    for (int i = 0; i < count; ++i) {
+        band.x[i] = rx(gen);
+        band.y[i] = ry(gen);
+    }
+    bands.push_back(move(band));
+    return (int)bands.size() - 1;
+}
+
+size_t Starfield::size() const
+{
+    size_t n = 0;
+    for (const StarBand &b : bands) n += b.y.size();
+    return n;
+}
+
+void Starfield::update()
+{
+    for (StarBand &b : bands) {
+        // saiu inteira por baixo -> volta inteira por cima (e vice-versa)
+        const float half = b.h * 0.5f;
+        advance(b.y.data(), b.y.size(), b.speed, -half, float(height) + half, float(height) + float(b.h));
+    }
+}
+
+// y += speed; y > high -> y -= span; y < low -> y += span
+void Starfield::advance(float *y, size_t n, float speed, float low, float high, float span)
+{
+    size_t i = 0;
+#if defined(ENGINE_HAVE_SSE2)
+    const __m128 vs = _mm_set1_ps(speed), vlo = _mm_set1_ps(low), vhi = _mm_set1_ps(high);
+    const __m128 vspan = _mm_set1_ps(span);
+    for (; i + 4 <= n; i += 4) {
+        __m128 v = _mm_add_ps(_mm_loadu_ps(y + i), vs);
+        v = _mm_sub_ps(v, _mm_and_ps(_mm_cmpgt_ps(v, vhi), vspan));
+        v = _mm_add_ps(v, _mm_and_ps(_mm_cmplt_ps(v, vlo), vspan));
+        _mm_storeu_ps(y + i, v);
+    }
+#endif
+    for (; i < n; ++i) {
+        float v = y[i] + speed;
+        if (v > high) v -= span;
+        else if (v < low) v += span;
+        y[i] = v;
+    }
+}
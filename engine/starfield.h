@@ -0,0 +1,45 @@
+#pragma once
+#include <vector>
+#include <random>
+#include <cstdint>
+#include "handles.h"
+#include "gameobject.h"
+
+using namespace std;
+
+// Uma faixa de velocidade do fundo: todas as estrelas têm a mesma imagem,
+// tamanho e velocidade, então só a posição fica por estrela (x, y = centro).
+struct StarBand {
+    TextureId image;
+    float     speed = 1.0f;      // pixels por passo (positivo = desce)
+    int       w = 1, h = 1;
+    Color     tint{255, 255, 255, 255};
+    vector<float> x, y;
+};
+
+// Fundo de estrelas em paralaxe. Cada passo soma a velocidade da faixa em y
+// e dá a volta na tela sem desvio (SSE2 quando disponível); o desenho é uma
+// sequência SPRITES com todas as estrelas, no depth do campo.
+class Starfield {
+public:
+    int  depth = 1;
+    bool visible = true;
+
+    void setBounds(int w, int h) { width = w; height = h; }
+
+    // count estrelas em posições aleatórias; retorna o índice da faixa
+    int  addBand(int count, float speed, TextureId image, int w, int h, Color tint = Color{255, 255, 255, 255});
+    void clear() { bands.clear(); }
+
+    void update();
+
+    size_t size() const;
+    const vector<StarBand>& getBands() const { return bands; }
+
+private:
+    int width = 0, height = 0;
+    vector<StarBand> bands;
+    mt19937 gen{ random_device{}() };
+
+    static void advance(float *y, size_t n, float speed, float low, float high, float span);
+};
@@ -0,0 +1,61 @@
+#include "textcache.h"
+
+static inline Uint32 packColor(SDL_Color c) {
+    return (Uint32(c.r) << 24) | (Uint32(c.g) << 16) | (Uint32(c.b) << 8) | Uint32(c.a);
+}
+
+const TextEntry* TextCache::get(SDL_Renderer *renderer, TTF_Font *font, const string &fontName,
+                                int fontSize, SDL_Color color, const string &text)
+{
+    TextKey key{ fontName, fontSize, packColor(color), text };
+
+    auto it = index.find(key);
+    if (it != index.end()) {
+        ++hits;
+        // move pra frente (mais recente)
+        if (it->second != lru.begin()) lru.splice(lru.begin(), lru, it->second);
+        return &it->second->second;
+    }
+
+    ++misses;
+    if (!renderer || !font) return nullptr;
+
+    SDL_Surface *surf = TTF_RenderUTF8_Blended(font, text.c_str(), color);
+    if (!surf) return nullptr;
+
+    SDL_Texture *tex = SDL_CreateTextureFromSurface(renderer, surf);
+    TextEntry entry{ tex, surf->w, surf->h };
+    SDL_FreeSurface(surf);
+    if (!tex) return nullptr;
+
+    lru.emplace_front(move(key), entry);
+    index[lru.front().first] = lru.begin();
+    evictOverflow();
+    return &lru.front().second;
+}
+
+void TextCache::evictOverflow()
+{
+    while (index.size() > capacity && !lru.empty()) {
+        auto &last = lru.back();
+        if (last.second.texture) SDL_DestroyTexture(last.second.texture);
+        index.erase(last.first);
+        lru.pop_back();
+        ++evictions;
+    }
+}
+
+void TextCache::setCapacity(size_t n)
+{
+    capacity = n > 0 ? n : 1;
+    evictOverflow();
+}
+
+void TextCache::clear()
+{
+    for (auto &item : lru) {
+        if (item.second.texture) SDL_DestroyTexture(item.second.texture);
+    }
+    lru.clear();
+    index.clear();
+}
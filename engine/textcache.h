@@ -0,0 +1,74 @@
+#pragma once
+#include <SDL2/SDL.h>
+#include <SDL2/SDL_ttf.h>
+#include <string>
+#include <list>
+#include <unordered_map>
+#include <cstdint>
+
+using namespace std;
+
+// Chave de um texto já renderizado: fonte + tamanho + cor + string
+struct TextKey {
+    string font;
+    int    size;
+    Uint32 color;  // RGBA empacotado
+    string text;
+    bool operator==(const TextKey &o) const {
+        return size == o.size && color == o.color && font == o.font && text == o.text;
+    }
+};
+struct TextKeyHash {
+    size_t operator()(const TextKey &k) const {
+        size_t h = hash<string>()(k.text);
+        h ^= hash<string>()(k.font) + 0x9e3779b9 + (h << 6) + (h >> 2);
+        h ^= hash<uint64_t>()((uint64_t(k.color) << 32) | uint32_t(k.size)) + 0x9e3779b9 + (h << 6) + (h >> 2);
+        return h;
+    }
+};
+
+struct TextEntry {
+    SDL_Texture *texture = nullptr;
+    int w = 0, h = 0;
+};
+
+// Cache LRU limitado de texturas de texto.
+// HUD que muda pouco vira lookup + um SDL_RenderCopy por frame.
+class TextCache {
+public:
+    explicit TextCache(size_t capacity = 128) : capacity(capacity) {}
+    ~TextCache() { clear(); }
+
+    TextCache(const TextCache&) = delete;
+    TextCache& operator=(const TextCache&) = delete;
+
+    // Retorna a textura do texto (renderiza e guarda se não existir). nullptr em erro.
+    const TextEntry* get(SDL_Renderer *renderer, TTF_Font *font, const string &fontName,
+                         int fontSize, SDL_Color color, const string &text);
+
+    // Libera todas as texturas (chamar antes de destruir o renderer)
+    void clear();
+
+    void   setCapacity(size_t n);
+    size_t getCapacity() const { return capacity; }
+    size_t size() const        { return index.size(); }
+
+    // --- estatísticas ---
+    uint64_t getHits() const      { return hits; }
+    uint64_t getMisses() const    { return misses; }
+    uint64_t getEvictions() const { return evictions; }
+    void resetStats() { hits = misses = evictions = 0; }
+
+private:
+    using Item = pair<TextKey, TextEntry>;
+
+    size_t capacity;
+    list<Item> lru;  // frente = mais recente
+    unordered_map<TextKey, list<Item>::iterator, TextKeyHash> index;
+
+    uint64_t hits = 0;
+    uint64_t misses = 0;
+    uint64_t evictions = 0;
+
+    void evictOverflow();
+};
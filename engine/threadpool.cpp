@@ -0,0 +1,67 @@
+#include "threadpool.h"
+
+void ThreadPool::start(int threads)
+{
+    stop();
+    quit = false;
+    for (int i = 1; i < threads; ++i) workers.emplace_back(&ThreadPool::workerLoop, this, i, generation);
+}
+
+void ThreadPool::stop()
+{
+    {
+        lock_guard<mutex> lock(m);
+        quit = true;
+    }
+    wake.notify_all();
+    for (thread &t : workers)
+        if (t.joinable()) t.join();
+    workers.clear();
+}
+
+void ThreadPool::run(int n, const Job &j)
+{
+    if (n <= 0) return;
+    if (workers.empty() || n == 1) {
+        for (int i = 0; i < n; ++i) j(i, 0);
+        return;
+    }
+
+    {
+        lock_guard<mutex> lock(m);
+        job   = &j;
+        count = n;
+        next  = 0;
+        busy  = (int)workers.size();
+        ++generation;
+    }
+    wake.notify_all();
+
+    work(0);
+
+    unique_lock<mutex> lock(m);
+    done.wait(lock, [this]{ return busy == 0; });
+    job = nullptr;
+}
+
+// seen começa na geração atual: a thread só pega lotes de run() posteriores
+void ThreadPool::workerLoop(int worker, uint64_t seen)
+{
+    unique_lock<mutex> lock(m);
+    while (true) {
+        wake.wait(lock, [&]{ return quit || generation != seen; });
+        if (quit) return;
+        seen = generation;
+
+        lock.unlock();
+        work(worker);
+        lock.lock();
+
+        if (--busy == 0) done.notify_one();
+    }
+}
+
+void ThreadPool::work(int worker)
+{
+    for (int i = next++; i < count; i = next++) (*job)(i, worker);
+}
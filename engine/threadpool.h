@@ -0,0 +1,46 @@
+#pragma once
+#include <vector>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <atomic>
+#include <functional>
+#include <cstdint>
+
+using namespace std;
+
+// Pool fixo de threads para trabalho em lotes: run() distribui `count` tarefas
+// (índice pego de um contador atômico) entre as threads e a própria thread que
+// chamou, e só retorna quando todas terminaram.
+class ThreadPool {
+public:
+    using Job = function<void(int index, int worker)>;   // worker em [0, size())
+
+    ThreadPool() = default;
+    ~ThreadPool() { stop(); }
+
+    ThreadPool(const ThreadPool&) = delete;
+    ThreadPool& operator=(const ThreadPool&) = delete;
+
+    // threads = total, contando quem chama run() (1 = sem threads extras)
+    void start(int threads);
+    void stop();
+    int  size() const { return (int)workers.size() + 1; }
+
+    void run(int count, const Job &job);
+
+private:
+    vector<thread> workers;
+    mutex m;
+    condition_variable wake;
+    condition_variable done;
+    const Job *job = nullptr;
+    int       count = 0;
+    atomic<int> next{0};
+    int       busy = 0;           // workers ainda no lote atual
+    uint64_t  generation = 0;     // muda a cada run()
+    bool      quit = false;
+
+    void workerLoop(int worker, uint64_t seen);
+    void work(int worker);
+};
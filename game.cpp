@@ -62,36 +62,38 @@ static const int ST_GAMEOVER = 5;
 
 void TargetsGame::carregaRecursos()
 {
-    // Images
-    g.loadImage("assets/images/title.png",            "title");
-    g.loadImage("assets/images/game_over.png",        "gover");
-    g.loadImage("assets/images/push_space_key2.png",  "push");
+    // Images (o último número é a maior escala em que aparecem: os níveis
+    // maiores que isso nem são carregados)
+    g.loadImage("assets/images/title.png",            "title", 0.4f);
+    g.loadImage("assets/images/game_over.png",        "gover", 0.5f);
+    g.loadImage("assets/images/push_space_key2.png",  "push",  0.5f);
     g.loadImage("assets/images/ship.png",             "nave_1");
     g.loadImage("assets/images/ship.png",             "nave_2");
     g.loadImage("assets/images/nave_tiro.png",        "tiro");
-    g.loadImage("assets/images/estrela.png",          "estrela");
-    g.loadImage("assets/images/energy_drop_1.png",    "energy");
-    g.loadImage("assets/images/game_over_alien1.png", "game_over_alien1");
+    g.loadImage("assets/images/estrela.png",          "estrela", 0.2f);
+    g.loadImage("assets/images/energy_drop_1.png",    "energy",  0.2f);
+    g.loadImage("assets/images/game_over_alien1.png", "game_over_alien1", 0.3f);
 
     g.loadImage("assets/images/background.png",       "background");
-    g.loadImage("assets/images/history.png",          "history");
-    g.loadImage("assets/images/truster.png",          "truster");
+    g.loadImage("assets/images/history.png",          "history", 0.6f);
+    img_truster = g.loadImage("assets/images/truster.png", "truster");
 
+    // inimigos só registrados: cada onda carrega os seus (prefetchOnda)
     for (int i = 0; i < TOTAL_ENEMY; i++)
     {
         string file = "assets/images/alien_" + to_string(i + 1) + ".png";
         string key = "alien_" + to_string(i + 1);
-        g.loadImage(file, key);
+        g.registerImage(file, key);
         g.splitImage(key, EXPL_SPLIT, key + "explode");
     }
 
     // Sound effects
-    g.loadSound("assets/sounds/nave_tiro.wav",        "tiro");
-    g.loadSound("assets/sounds/inimigo_explode.wav",  "explosao");
-    g.loadSound("assets/sounds/impact1.wav",          "impact1");
+    snd_tiro       = g.loadSound("assets/sounds/nave_tiro.wav",        "tiro");
+    snd_explosao   = g.loadSound("assets/sounds/inimigo_explode.wav",  "explosao");
+    snd_impact     = g.loadSound("assets/sounds/impact1.wav",          "impact1");
     g.loadSound("assets/sounds/push_space.ogg",       "push_space");
     g.loadSound("assets/sounds/game_over_voice3.wav", "game_over");
-    g.loadSound("assets/sounds/energy_get.wav",       "energy_get");
+    snd_energy_get = g.loadSound("assets/sounds/energy_get.wav",       "energy_get");
 
     // Musics
     g.loadMusic("assets/musics/title_music.wav",      "title_music");
@@ -99,20 +101,33 @@ void TargetsGame::carregaRecursos()
     g.loadMusic("assets/musics/game_over_music.wav",  "game_over_music");
 }
 
-void TargetsGame::inimigoExplosao(Object o)
+// Carrega em segundo plano os inimigos da onda (as partes da explosão vêm junto)
+void TargetsGame::prefetchOnda(int onda)
 {
-    string base = o.images[0] + "explode";
+    if (onda < 1 || onda > (int)WAVE_ENEMY_TYPE.size()) return;
+    for (int tipo : WAVE_ENEMY_TYPE[onda - 1])
+        g.prefetchImage("alien_" + to_string(tipo));
+}
+
+void TargetsGame::inimigoExplosao(const Object &o)
+{
+    const string base = g.getImageTag(o.images[0]) + "explode";
+    const float fw = o.getW() / 3, fh = o.getH() / 3;
     for (int i = 0; i < EXPL_SPLIT; i++)
     {
-        Object *go = g.createObject(o.getX(), o.getY(), o.getW() / 3, o.getH() / 3, base + to_string(i), 0, 2);
-        go->setImageSpeed(0.05); // so pra destruir
-        go->setAngleSpeed(g.choose({4, 8, 12}));
-        go->setForce(o.getForceX() / 2, o.getForceY() / 2);
-        go->setImpulseDirection(g.choose(20, 40, 60, 80, 110, 130, 150, 170),  g.choose({3, 4, 5}));
-        go->onAnimationEnd = [this](Object *self)
-        {
-            g.requestDestroy(self);
-        };
+        const float dir = g.choose(20, 40, 60, 80, 110, 130, 150, 170) * float(M_PI / 180.0);
+        const float speed = g.choose({3, 4, 5});
+        Particle p;
+        p.x     = o.getX();   // centro do inimigo (Object é centrado)
+        p.y     = o.getY();
+        p.w     = fw;
+        p.h     = fh;
+        p.vx    = o.getForceX() / 2 + cosf(dir) * speed;
+        p.vy    = o.getForceY() / 2 - sinf(dir) * speed;
+        p.spin  = g.choose({4, 8, 12});
+        p.life  = 20;
+        p.frame = g.findImage(base + to_string(i));
+        g.emitParticle(fx_debris, p);
     }
 }
 
@@ -131,6 +146,9 @@ void TargetsGame::mudaEstado(int estado_mudar)
     {
         g.requestDestroyAllTypeBut(TYPE_STAR);
         criaObjetos("wave");
+        // o banner dura 3s: dá tempo de decodificar esta onda e a seguinte
+        prefetchOnda(wave);
+        prefetchOnda(wave + 1);
     }
 
     if (estado_mudar == ST_PLAYING)
@@ -175,6 +193,7 @@ void TargetsGame::criaObjetos(string_view qual)
     {
         background = g.createObject(0, 0, g.getW(), g.getH(), "background", TYPE_BACKGROUND, 100);
         background->setCentered(false);
+        background->setStatic(true);
         return;
     }
 
@@ -246,7 +265,7 @@ void TargetsGame::criaObjetos(string_view qual)
     if (qual == "nave")
     {
         nave = g.createObject(400, 450, 64, 64, "nave_1", 0, 5);
-        nave->images.push_back("nave_2");
+        nave->addImageRef("nave_2");
         nave->setImageSpeed(0.2);
         nave->setImageCycle(ImageCycle::LOOP);
         nave->setWrap(true, true);
@@ -260,6 +279,12 @@ void TargetsGame::criaObjetos(string_view qual)
                 nave->addY(-5);
             if (g.keyHeld(SDL_SCANCODE_DOWN))
                 nave->addY(5);
+
+            if (ParticleEmitter *fogo = g.getEmitter(fx_truster))
+            {
+                fogo->setOrigin(nave->getX(), nave->getY());
+                fogo->visible = nave->isVisible();
+            }
         };
 
         nave->setCollisionGroup(-1); // nao colide
@@ -297,34 +322,19 @@ void TargetsGame::criaObjetos(string_view qual)
             {
                 nave->setAlarm(4, 3);
                 int aux[] = {-24, 25};
+                const SDL_Point size = g.getImageSize(img_truster);
                 for (int i = 0; i < 2; i++)
                 {
-                    Object *truster = g.createObject(0, 0, 0, 0, "truster", TYPE_TRUSTER, 6);
-                    truster->setTag(aux[i]);
-                    truster->setX(nave->getX() + aux[i]);
-                    truster->setY(nave->getY() + nave->getH() - 25);
-                    truster->setScale(0.7);
-                    truster->setParent(nave);
-                    truster->setAlarm(7, 1);
-                    truster->setCentered(true);
-                    truster->setGlow(255, 255, 255, 3, 200);
-                    truster->setDirection(270, 2);
-                    truster->onAlarmFinished = [this](Object *me, int id)
-                    {
-                        me->requestDestroy();
-                    };
-                    truster->onAfterCalculate = [this](Object *me) 
-                    {
-                        if (g.keyHeld(SDL_SCANCODE_RIGHT))
-                            me->addX(5);
-                        if (g.keyHeld(SDL_SCANCODE_LEFT))
-                            me->addX(-5);
-                        if (g.keyHeld(SDL_SCANCODE_UP))
-                            me->addY(-5);
-                        if (g.keyHeld(SDL_SCANCODE_DOWN))
-                            me->addY(5);
-                        me->setVisible(me->getParent()->isVisible());
-                    };
+                    // posição relativa à nave: o emissor acompanha a origem
+                    Particle p;
+                    p.x     = aux[i];
+                    p.y     = nave->getH() - 25;
+                    p.w     = size.x * 0.7f;
+                    p.h     = size.y * 0.7f;
+                    p.vy    = 2;
+                    p.life  = 7;
+                    p.frame = img_truster;
+                    g.emitParticle(fx_truster, p);
                 }
             }
         };
@@ -334,7 +344,7 @@ void TargetsGame::criaObjetos(string_view qual)
             {
                 this->energy = min(this->energy + 10, MAX_ENERGY);
                 other->requestDestroy();
-                g.playSound("energy_get");
+                g.playSound(snd_energy_get);
             }
         };
 
@@ -396,6 +406,7 @@ void TargetsGame::criaObjetos(string_view qual)
         hud_score = g.createObject(20, 10, 64, 64, "", TYPE_HUD, -5);
         hud_score->setFont("Roboto_Condensed-Black.ttf", 24, hud_score->withAlpha(Object::COLOR_YELLOW, 140));
         hud_score->setCentered(false);
+        hud_score->setTextDynamic(true);
         hud_score->onBeforeDraw = [this](Object *self)
         {
             self->setText("SCORE: " + g.padzero(score, 4));
@@ -412,6 +423,7 @@ void TargetsGame::criaObjetos(string_view qual)
         hud_hi = g.createObject(g.getW() - 40 - 60, 10, 64, 64, "", TYPE_HUD, -5);
         hud_hi->setFont("Roboto_Condensed-Black.ttf", 24, hud_score->withAlpha(Object::COLOR_YELLOW, 140));
         hud_hi->setCentered(false);
+        hud_hi->setTextDynamic(true);
         hud_hi->onBeforeDraw = [this](Object *self)
         {
             self->setText("HI: " + g.padzero(hi, 4));
@@ -437,6 +449,7 @@ void TargetsGame::criaObjetos(string_view qual)
         hud_debug = g.createObject(g.getW() - 80, g.getH() - 40, 64, 64, "", TYPE_HUD, -5);
         hud_debug->setFont("Roboto_Condensed-Black.ttf", 24, hud_debug->withAlpha(Object::COLOR_YELLOW, 140));
         hud_debug->setCentered(false);
+        hud_debug->setTextDynamic(true);
         hud_debug->onBeforeDraw = [this](Object *self)
         {
             self->setText("c: " + std::to_string(g.countObject()));
@@ -472,7 +485,7 @@ void TargetsGame::criaObjetos(string_view qual)
             if (other->destroyIfLowEnergy())
             {
                 inimigoExplosao(*other);
-                g.playSound("explosao");
+                g.playSound(snd_explosao);
                 score += 10;
                 hi    += 10;
                 kills += 1;
@@ -526,10 +539,10 @@ void TargetsGame::criaObjetos(string_view qual)
                 other->setImpulseDirection(90, g.choose(4, 5, 6));
                 other->setImpulseFriction(0.05);
 
-                g.playSound("impact1");
+                g.playSound(snd_impact);
             }
         };
-        g.playSound("tiro");
+        g.playSound(snd_tiro);
         return;
     }
 
@@ -580,20 +593,18 @@ void TargetsGame::criaObjetos(string_view qual)
 
     if (qual == "estrelas")
     {
-        float scales[] = {0.05, 0.1, 0.2};
-        for (int i = 0; i < TOTAL_STARS; i++)
+        // três faixas de paralaxe: quanto menor a estrela, mais devagar
+        const float scales[] = {0.05, 0.1, 0.2};
+        const float speeds[] = {0.5, 1, 1.5};
+        const TextureId img = g.findImage("estrela");
+        const SDL_Point size = g.getImageSize(img);
+        Starfield &stars = g.getStarfield();
+        stars.clear();
+        stars.depth = 1;
+        for (int i = 0; i < 3; i++)
         {
-            Object *o = g.createObject(g.RANDOM_X, g.RANDOM_Y, 0, 0, "estrela", TYPE_STAR, 1);
-            float force = g.choose(0.5, 1, 1.5); 
-            o->setForceY(force);
-            if (force == 0.5)
-                o->setScale(scales[0]);
-            if (force == 1)
-                o->setScale(scales[1]);
-            if (force == 1.5)
-                o->setScale(scales[2]);
-            o->setCollisionGroup(-1);
-            o->setWrap(true, true);
+            const int count = TOTAL_STARS / 3 + (i < TOTAL_STARS % 3 ? 1 : 0);
+            stars.addBand(count, speeds[i], img, max(1, int(size.x * scales[i])), max(1, int(size.y * scales[i])));
         }
         return;
     }
@@ -608,14 +619,26 @@ int TargetsGame::run()
 
     if (!g.init("Targets", 600, 800))
         return 1;
+    g.setThreaded(true);   // simula o próximo frame enquanto apresenta o atual
+    g.setBloom(true);      // um blur de tela cheia no lugar dos halos de cada objeto
 
     carregaRecursos();
+    // o atlas é fixo; os inimigos de ondas passadas saem quando passar de 4 MB
+    g.setImageBudget(g.memoryReport().atlasBytes + 4 * 1024 * 1024);
+
+    fx_debris  = g.createEmitter(2);
+    FxParams fogo;
+    fogo.glowRadius = 3;
+    fogo.glow_r = fogo.glow_g = fogo.glow_b = 255;
+    fogo.glow_a = 200;
+    fx_truster = g.createEmitter(6, fogo);
     criaObjetos("estrelas");
 
     mudaEstado(ST_TITLE);
 
     hi = 0;
-    while (g.running)
+    // roda a cada passo da simulação (taxa fixa), não a cada frame desenhado
+    g.onStep = [this]()
     {
         if (state == ST_PLAYING)
         {
@@ -631,6 +654,10 @@ int TargetsGame::run()
                 criaObjetos("inimigos");
             }
         }
+    };
+
+    while (g.running)
+    {
         g.calculateAndRender();
     }
 
@@ -22,6 +22,17 @@ public:
 
     Object *display_wave = nullptr;
 
+    // sons tocados durante o jogo (handles resolvidos no carregamento)
+    SoundId snd_tiro;
+    SoundId snd_explosao;
+    SoundId snd_impact;
+    SoundId snd_energy_get;
+
+    // partículas: pedaços das explosões e fogo dos propulsores
+    EmitterId fx_debris;
+    EmitterId fx_truster;
+    TextureId img_truster;
+
     int score  = 0;
     int hi     = 0;
     int lifes  = 2;
@@ -33,9 +44,10 @@ public:
     int music_volume = 128 / 2; // 128 é o máximo
     int sound_volume = 128;
 
-    void inimigoExplosao(Object o);
+    void inimigoExplosao(const Object &o);
     void mudaEstado(int estado);
     void carregaRecursos();
+    void prefetchOnda(int onda);
     void criaObjetos(string_view qual);
 
     TargetsGame() = default;